@@ -0,0 +1,122 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/basic_observers.h"
+#include "mir/thread_safe_list.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct Observer
+{
+    virtual ~Observer() = default;
+    virtual void frame_posted() = 0;
+};
+
+struct CountingObserver : Observer
+{
+    void frame_posted() override { count.fetch_add(1, std::memory_order_relaxed); }
+    std::atomic<uint64_t> count{0};
+};
+
+// Notifies as SurfaceObservers does
+struct Observers : Observer, mir::BasicObservers<Observer>
+{
+    using mir::BasicObservers<Observer>::add;
+
+    void frame_posted() override
+    {
+        for_each([](std::shared_ptr<Observer> const& observer) { observer->frame_posted(); });
+    }
+};
+
+// Notifies as BasicObservers did before it read its list without locking
+struct LockingObservers : Observer, mir::ThreadSafeList<std::shared_ptr<Observer>>
+{
+    void frame_posted() override
+    {
+        for_each([](std::shared_ptr<Observer> const& observer) { observer->frame_posted(); });
+    }
+};
+
+// Each thread posts frames to its own surface's observers, or all to the same surface's
+template<typename Notifier>
+double notifications_per_second(int threads, bool shared, int observer_count, uint64_t frames)
+{
+    std::vector<std::unique_ptr<Notifier>> surfaces;
+    for (int i = 0; i != (shared ? 1 : threads); ++i)
+    {
+        surfaces.push_back(std::make_unique<Notifier>());
+        for (int j = 0; j != observer_count; ++j)
+            surfaces.back()->add(std::make_shared<CountingObserver>());
+    }
+
+    std::atomic<bool> go{false};
+    std::vector<std::thread> notifiers;
+    for (int i = 0; i != threads; ++i)
+    {
+        auto const surface = surfaces[shared ? 0 : i].get();
+        notifiers.emplace_back([&go, surface, frames]
+            {
+                while (!go) std::this_thread::yield();
+                for (uint64_t i = 0; i != frames; ++i)
+                    surface->frame_posted();
+            });
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    go = true;
+    for (auto& notifier : notifiers)
+        notifier.join();
+    std::chrono::duration<double> const duration = std::chrono::steady_clock::now() - start;
+
+    return threads * frames * observer_count / duration.count();
+}
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 2)
+    {
+        std::cout<<"Usage: "<<argv[0]<<" <frames per thread>"<<std::endl;
+        exit(1);
+    }
+
+    uint64_t const frames = std::atoll(argv[1]);
+
+    std::cout<<"threads, surfaces, observers, locking (notifications/s), lock-free (notifications/s)"<<std::endl;
+    for (int threads : {1, 4})
+    {
+        for (bool shared : {false, true})
+        {
+            if (threads == 1 && shared) continue;
+
+            for (int observer_count : {5, 10})
+            {
+                std::cout<<threads<<", "<<(shared ? 1 : threads)<<", "<<observer_count<<", "
+                         <<notifications_per_second<LockingObservers>(threads, shared, observer_count, frames)<<", "
+                         <<notifications_per_second<Observers>(threads, shared, observer_count, frames)<<std::endl;
+            }
+        }
+    }
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/scene/mediating_display_changer.h"
+#include "src/server/scene/broadcasting_session_event_sink.h"
+#include "mir/compositor/compositor.h"
+#include "mir/graphics/display_configuration_observer.h"
+#include "mir/graphics/display_configuration_policy.h"
+#include "mir/server_action_queue.h"
+
+#include "mir/test/doubles/fake_alarm_factory.h"
+#include "mir/test/doubles/fake_display.h"
+#include "mir/test/doubles/stub_display_configuration.h"
+#include "mir/test/doubles/stub_session.h"
+#include "mir/test/doubles/stub_session_container.h"
+#include "mir/test/fake_shared.h"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace mc = mir::compositor;
+namespace mf = mir::frontend;
+namespace mg = mir::graphics;
+namespace ms = mir::scene;
+namespace mt = mir::test;
+namespace mtd = mir::test::doubles;
+
+namespace
+{
+// Roughly what real hardware takes to change mode
+std::chrono::milliseconds const modeset_time{20};
+
+// Like the KMS platform: transform-only changes are cheap, anything else is a full modeset
+struct ModesettingDisplay : mtd::FakeDisplay
+{
+    using mtd::FakeDisplay::FakeDisplay;
+
+    void configure(mg::DisplayConfiguration const& conf) override
+    {
+        std::this_thread::sleep_for(modeset_time);
+        ++modesets;
+        mtd::FakeDisplay::configure(conf);
+    }
+
+    bool configure_changed_outputs(
+        mg::DisplayConfiguration const&,
+        std::function<void(mg::DisplaySyncGroup&)> const&) override
+    {
+        return false;
+    }
+
+    int modesets{0};
+};
+
+struct NullCompositor : mc::Compositor
+{
+    void start() override {}
+    void stop() override {}
+};
+
+struct NullDisplayConfigurationPolicy : mg::DisplayConfigurationPolicy
+{
+    void apply_to(mg::DisplayConfiguration&) override {}
+};
+
+struct NullDisplayConfigurationObserver : mg::DisplayConfigurationObserver
+{
+    void initial_configuration(std::shared_ptr<mg::DisplayConfiguration const> const&) override {}
+    void configuration_applied(std::shared_ptr<mg::DisplayConfiguration const> const&) override {}
+    void base_configuration_updated(std::shared_ptr<mg::DisplayConfiguration const> const&) override {}
+    void session_configuration_applied(
+        std::shared_ptr<mf::Session> const&,
+        std::shared_ptr<mg::DisplayConfiguration> const&) override {}
+    void session_configuration_removed(std::shared_ptr<mf::Session> const&) override {}
+    void configuration_failed(
+        std::shared_ptr<mg::DisplayConfiguration const> const&,
+        std::exception const&) override {}
+    void catastrophic_configuration_error(
+        std::shared_ptr<mg::DisplayConfiguration const> const&,
+        std::exception const&) override {}
+};
+
+struct SynchronousServerActionQueue : mir::ServerActionQueue
+{
+    void enqueue(void const*, mir::ServerAction const& action) override { action(); }
+    void enqueue_with_guaranteed_execution(mir::ServerAction const& action) override { action(); }
+    void pause_processing_for(void const*) override {}
+    void resume_processing_for(void const*) override {}
+};
+
+void alt_tab(
+    std::string const& name,
+    std::function<void(mg::UserDisplayConfigurationOutput&)> const& change,
+    int switches)
+{
+    ModesettingDisplay display{{{{0, 0}, {1920, 1080}}, {{1920, 0}, {1920, 1080}}}};
+    NullCompositor compositor;
+    NullDisplayConfigurationPolicy policy;
+    mtd::StubSessionContainer sessions;
+    ms::BroadcastingSessionEventSink session_event_sink;
+    SynchronousServerActionQueue action_queue;
+    NullDisplayConfigurationObserver observer;
+    mtd::FakeAlarmFactory alarm_factory;
+
+    ms::MediatingDisplayChanger changer{
+        mt::fake_shared(display),
+        mt::fake_shared(compositor),
+        mt::fake_shared(policy),
+        mt::fake_shared(sessions),
+        mt::fake_shared(session_event_sink),
+        mt::fake_shared(action_queue),
+        mt::fake_shared(observer),
+        mt::fake_shared(alarm_factory)};
+
+    auto const desktop = std::make_shared<mtd::StubSession>();
+    auto const game = std::make_shared<mtd::StubSession>();
+
+    std::shared_ptr<mg::DisplayConfiguration> const game_conf{display.configuration()};
+    game_conf->for_each_output(change);
+    changer.configure(game, game_conf);
+
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i != switches; ++i)
+    {
+        session_event_sink.handle_focus_change(game);
+        session_event_sink.handle_focus_change(desktop);
+    }
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << name << ", "
+              << std::chrono::duration<double, std::micro>(elapsed).count() / (2 * switches) << ", "
+              << display.modesets << std::endl;
+}
+}
+
+int main(int argc, char** argv)
+{
+    int const switches = argc > 1 ? std::stoi(argv[1]) : 50;
+
+    std::cout << "game configuration, mean focus switch (us), modesets" << std::endl;
+
+    alt_tab("same as desktop", [](mg::UserDisplayConfigurationOutput&) {}, switches);
+
+    alt_tab("rotated", [](mg::UserDisplayConfigurationOutput& output)
+        {
+            output.orientation = mir_orientation_left;
+        },
+        switches);
+
+    alt_tab("scaled", [](mg::UserDisplayConfigurationOutput& output)
+        {
+            output.scale = 2.0f;
+        },
+        switches);
+
+    alt_tab("repositioned", [](mg::UserDisplayConfigurationOutput& output)
+        {
+            output.top_left = {output.top_left.x.as_int(), 100};
+        },
+        switches);
+}
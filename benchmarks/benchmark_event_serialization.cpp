@@ -0,0 +1,57 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/events/event.h"
+#include "mir/events/event_builders.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace mev = mir::events;
+
+namespace
+{
+template<typename Operation>
+void report(char const* name, int iterations, Operation const& operation)
+{
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i != iterations; ++i)
+        operation();
+    auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    std::cout << name << ": " << iterations / elapsed.count() << " events/s" << std::endl;
+}
+}
+
+int main(int argc, char** argv)
+{
+    int const iterations = argc > 1 ? std::stoi(argv[1]) : 1000000;
+
+    auto const event = mev::make_event(
+        MirInputDeviceId{1}, std::chrono::nanoseconds{1}, std::vector<uint8_t>{},
+        mir_keyboard_action_down, 0x61, 30, mir_input_event_modifier_none);
+
+    report("serialize to new string", iterations,
+        [&] { MirEvent::serialize(event.get()); });
+
+    std::string buffer;
+    report("serialize into reused buffer", iterations,
+        [&] { MirEvent::serialize(event.get(), buffer); });
+
+    report("deserialize", iterations,
+        [&] { MirEvent::deserialize(buffer); });
+}
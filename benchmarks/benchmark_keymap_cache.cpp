@@ -0,0 +1,109 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_wayland/keymap_cache.h"
+#include "mir/anonymous_shm_file.h"
+#include "mir/input/keymap.h"
+
+#include <xkbcommon/xkbcommon.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mf = mir::frontend;
+namespace mi = mir::input;
+
+namespace
+{
+// What each wl_keyboard held before keymaps were shared
+struct UncachedKeyboard
+{
+    UncachedKeyboard(mi::Keymap const& names) :
+        context{xkb_context_new(XKB_CONTEXT_NO_FLAGS), &xkb_context_unref},
+        keymap{nullptr, &xkb_keymap_unref},
+        state{nullptr, &xkb_state_unref}
+    {
+        xkb_rule_names const rule_names = {
+            "evdev", names.model.c_str(), names.layout.c_str(), names.variant.c_str(), names.options.c_str()};
+        keymap.reset(xkb_keymap_new_from_names(context.get(), &rule_names, XKB_KEYMAP_COMPILE_NO_FLAGS));
+        state.reset(xkb_state_new(keymap.get()));
+
+        std::unique_ptr<char, void(*)(void*)> buffer{xkb_keymap_get_as_string(keymap.get(), XKB_KEYMAP_FORMAT_TEXT_V1), free};
+        auto const length = strlen(buffer.get());
+        shm_buffer = std::make_unique<mir::AnonymousShmFile>(length);
+        memcpy(shm_buffer->base_ptr(), buffer.get(), length);
+    }
+
+    std::unique_ptr<xkb_context, void (*)(xkb_context*)> context;
+    std::unique_ptr<xkb_keymap, void (*)(xkb_keymap*)> keymap;
+    std::unique_ptr<xkb_state, void (*)(xkb_state*)> state;
+    std::unique_ptr<mir::AnonymousShmFile> shm_buffer;
+};
+
+struct CachedKeyboard
+{
+    CachedKeyboard(mi::Keymap const& names, mf::KeymapCache& cache) :
+        keymap{cache.from_names(names)},
+        state{xkb_state_new(keymap->keymap()), &xkb_state_unref},
+        fd{keymap->client_fd()}
+    {
+    }
+
+    std::shared_ptr<mf::CompiledKeymap const> keymap;
+    std::unique_ptr<xkb_state, void (*)(xkb_state*)> state;
+    mir::Fd fd;
+};
+
+template<typename Setup>
+double seconds_for(Setup const& setup)
+{
+    auto const start = std::chrono::steady_clock::now();
+    setup();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+int main(int argc, char** argv)
+{
+    int const max_clients = argc > 1 ? std::stoi(argv[1]) : 200;
+    mi::Keymap const names;
+
+    std::cout << "clients, uncached seat setup (s), cached seat setup (s)" << std::endl;
+
+    for (int clients = 1; clients <= max_clients; clients *= 2)
+    {
+        std::vector<std::unique_ptr<UncachedKeyboard>> uncached;
+        auto const uncached_time = seconds_for([&]
+            {
+                for (int i = 0; i != clients; ++i)
+                    uncached.push_back(std::make_unique<UncachedKeyboard>(names));
+            });
+
+        mf::KeymapCache cache;
+        std::vector<std::unique_ptr<CachedKeyboard>> cached;
+        auto const cached_time = seconds_for([&]
+            {
+                for (int i = 0; i != clients; ++i)
+                    cached.push_back(std::make_unique<CachedKeyboard>(names, cache));
+            });
+
+        std::cout << clients << ", " << uncached_time << ", " << cached_time << std::endl;
+    }
+}
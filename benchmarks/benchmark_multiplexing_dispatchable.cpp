@@ -17,6 +17,7 @@
  */
 
 #include "mir/dispatch/multiplexing_dispatchable.h"
+#include "mir/dispatch/batching_dispatchable.h"
 
 #include <iostream>
 #include <vector>
@@ -24,6 +25,7 @@
 #include <chrono>
 #include <thread>
 #include <poll.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 
 namespace md = mir::dispatch;
@@ -82,11 +84,100 @@ bool fd_is_readable(int fd)
     return poll(&poller, 1, 0);
 }
 
+// Stays ready (like a busy client socket) until the benchmark is done with it
+class ReadyDispatchable : public md::Dispatchable
+{
+public:
+    ReadyDispatchable(uint64_t& dispatch_count)
+        : fd{eventfd(1, EFD_CLOEXEC)},
+          dispatch_count(dispatch_count)
+    {
+        if (fd < 0)
+        {
+            throw std::system_error{errno, std::system_category(), "Failed to create eventfd"};
+        }
+    }
+
+    mir::Fd watch_fd() const override
+    {
+        return fd;
+    }
+    bool dispatch(md::FdEvents) override
+    {
+        ++dispatch_count;
+        return true;
+    }
+    md::FdEvents relevant_events() const override
+    {
+        return md::FdEvent::readable;
+    }
+
+private:
+    mir::Fd const fd;
+    uint64_t& dispatch_count;
+};
+
+// Dispatches as a ThreadedDispatcher's thread does: waiting for the dispatcher's fd each time round
+double events_per_second(int ready_fds, std::size_t batch, uint64_t event_count)
+{
+    auto const multiplexer = std::make_shared<md::MultiplexingDispatchable>();
+    uint64_t dispatched{0};
+
+    for (int i = 0; i < ready_fds; ++i)
+    {
+        multiplexer->add_watch(std::make_shared<ReadyDispatchable>(dispatched));
+    }
+
+    // A batch of 1 is the multiplexer on its own
+    std::shared_ptr<md::Dispatchable> const dispatcher = batch == 1 ?
+        std::shared_ptr<md::Dispatchable>{multiplexer} :
+        std::make_shared<md::BatchingDispatchable>(multiplexer, batch);
+
+    auto start = std::chrono::steady_clock::now();
+
+    while (dispatched < event_count && fd_is_readable(dispatcher->watch_fd()))
+    {
+        dispatcher->dispatch(md::FdEvent::readable);
+    }
+
+    std::chrono::duration<double> const duration = std::chrono::steady_clock::now() - start;
+    return dispatched / duration.count();
+}
+
+void compare_batch_sizes(uint64_t event_count)
+{
+    std::size_t const batches[] = {1, 16, 64};
+
+    std::cout<<"ready fds";
+    for (auto batch : batches)
+    {
+        std::cout<<", batch "<<batch<<" (events/s)";
+    }
+    std::cout<<std::endl;
+
+    for (int ready_fds : {1, 10, 100, 1000})
+    {
+        std::cout<<ready_fds;
+        for (auto batch : batches)
+        {
+            std::cout<<", "<<events_per_second(ready_fds, batch, event_count);
+        }
+        std::cout<<std::endl;
+    }
+}
+
 int main(int argc, char** argv)
 {
+    if (argc == 2)
+    {
+        compare_batch_sizes(std::atoll(argv[1]));
+        exit(0);
+    }
+
     if (argc != 3)
     {
         std::cout<<"Usage: "<<argv[0]<<" <number of threads> <dispatch count>"<<std::endl;
+        std::cout<<"       "<<argv[0]<<" <dispatch count>    (compares batch sizes for 1 to 1000 ready fds)"<<std::endl;
         exit(1);
     }
 
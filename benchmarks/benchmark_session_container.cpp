@@ -0,0 +1,185 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/scene/default_session_container.h"
+#include "src/server/scene/prompt_session_container.h"
+
+#include "mir/test/doubles/null_prompt_session.h"
+#include "mir/test/doubles/stub_session.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ms = mir::scene;
+namespace mtd = mir::test::doubles;
+
+namespace
+{
+// What DefaultSessionContainer did before sessions were indexed
+class VectorSessionContainer : public ms::SessionContainer
+{
+public:
+    void insert_session(std::shared_ptr<ms::Session> const& session) override
+    {
+        std::unique_lock<std::mutex> lk(guard);
+        apps.push_back(session);
+    }
+
+    void remove_session(std::shared_ptr<ms::Session> const& session) override
+    {
+        std::unique_lock<std::mutex> lk(guard);
+
+        auto it = std::find(apps.begin(), apps.end(), session);
+        if (it == apps.end())
+            BOOST_THROW_EXCEPTION(std::logic_error("Invalid Session"));
+
+        apps.erase(it);
+    }
+
+    void for_each(std::function<void(std::shared_ptr<ms::Session> const&)> f) const override
+    {
+        std::unique_lock<std::mutex> lk(guard);
+
+        for (auto const& ptr : apps)
+            f(ptr);
+    }
+
+    std::shared_ptr<ms::Session> successor_of(std::shared_ptr<ms::Session> const& session) const override
+    {
+        if (!session)
+            return apps.empty() ? std::shared_ptr<ms::Session>() : apps.back();
+
+        auto it = std::find(apps.begin(), apps.end(), session);
+        if (it == apps.end())
+            BOOST_THROW_EXCEPTION(std::logic_error("Invalid session"));
+
+        return ++it == apps.end() ? apps.front() : *it;
+    }
+
+private:
+    std::vector<std::shared_ptr<ms::Session>> apps;
+    mutable std::mutex guard;
+};
+
+template<typename Storm>
+double seconds_for(Storm const& storm)
+{
+    auto const start = std::chrono::steady_clock::now();
+    storm();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Connect all the clients, cycle focus through them all, then disconnect them in an arbitrary order
+double session_storm(ms::SessionContainer& container, std::vector<std::shared_ptr<ms::Session>> const& clients)
+{
+    auto disconnect_order = clients;
+    std::shuffle(disconnect_order.begin(), disconnect_order.end(), std::default_random_engine{});
+
+    return seconds_for([&]
+        {
+            for (auto const& client : clients)
+                container.insert_session(client);
+
+            auto focus = container.successor_of({});
+            for (auto i = 0u; i != clients.size(); ++i)
+                focus = container.successor_of(focus);
+
+            for (auto const& client : disconnect_order)
+                container.remove_session(client);
+        });
+}
+
+// Each client is a prompt provider for a prompt session of its own and the shared one, then disconnects
+double prompt_session_storm(std::vector<std::shared_ptr<ms::Session>> const& clients)
+{
+    using ParticipantType = ms::PromptSessionContainer::ParticipantType;
+
+    ms::PromptSessionContainer container;
+    auto const shared = std::make_shared<mtd::NullPromptSession>();
+    std::vector<std::shared_ptr<ms::PromptSession>> own(clients.size());
+
+    return seconds_for([&]
+        {
+            container.insert_prompt_session(shared);
+
+            for (auto i = 0u; i != clients.size(); ++i)
+            {
+                own[i] = std::make_shared<mtd::NullPromptSession>();
+                container.insert_prompt_session(own[i]);
+                container.insert_participant(own[i].get(), clients[i], ParticipantType::prompt_provider);
+                container.insert_participant(shared.get(), clients[i], ParticipantType::prompt_provider);
+            }
+
+            // As PromptSessionManagerImpl::remove_session() does
+            for (auto i = 0u; i != clients.size(); ++i)
+            {
+                std::vector<std::pair<ms::PromptSession*, ParticipantType>> participation;
+                container.for_each_prompt_session_with_participant(clients[i],
+                    [&](std::shared_ptr<ms::PromptSession> const& prompt_session, ParticipantType type)
+                    {
+                        participation.emplace_back(prompt_session.get(), type);
+                    });
+
+                for (auto const& p : participation)
+                    container.remove_participant(p.first, clients[i], p.second);
+
+                container.remove_prompt_session(own[i]);
+            }
+
+            container.remove_prompt_session(shared);
+        });
+}
+}
+
+int main(int argc, char** argv)
+{
+    int const max_clients = argc > 1 ? std::stoi(argv[1]) : 1000;
+    int const repeats = 10;
+
+    std::cout << "clients, vector sessions (s), indexed sessions (s), prompt sessions (s)" << std::endl;
+
+    for (int clients = 125; clients <= max_clients; clients *= 2)
+    {
+        std::vector<std::shared_ptr<ms::Session>> sessions;
+        for (int i = 0; i != clients; ++i)
+            sessions.push_back(std::make_shared<mtd::StubSession>(i));
+
+        double vector_time = 0, indexed_time = 0, prompt_time = 0;
+
+        for (int i = 0; i != repeats; ++i)
+        {
+            VectorSessionContainer vector_container;
+            vector_time += session_storm(vector_container, sessions);
+
+            ms::DefaultSessionContainer indexed_container;
+            indexed_time += session_storm(indexed_container, sessions);
+
+            prompt_time += prompt_session_storm(sessions);
+        }
+
+        std::cout << clients << ", " << vector_time/repeats << ", " << indexed_time/repeats
+                  << ", " << prompt_time/repeats << std::endl;
+    }
+}
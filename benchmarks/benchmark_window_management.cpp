@@ -0,0 +1,123 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "window_manager_harness.h"
+
+#include <miral/application_info.h>
+
+#include <mir/shell/surface_specification.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace ms = mir::scene;
+namespace msh = mir::shell;
+using namespace mir::geometry;
+using namespace mir_benchmark;
+
+namespace
+{
+int const windows_per_client = 50;
+
+template<typename Work>
+double mean_us(int count, Work const& work)
+{
+    auto const start = std::chrono::steady_clock::now();
+    work();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / count;
+}
+
+void manage(int windows)
+{
+    WindowManagerHarness<NullInputPolicy> harness;
+    auto& window_manager = harness.window_manager;
+    auto& tools = harness.tools;
+
+    window_manager.add_display_for_testing({{0, 0}, {1920, 1080}});
+
+    std::vector<std::shared_ptr<ClientSession>> clients;
+    for (int i = 0; i < windows; i += windows_per_client)
+    {
+        clients.push_back(std::make_shared<ClientSession>());
+        window_manager.add_session(clients.back());
+    }
+
+    ms::SurfaceCreationParameters params;
+    params.size = {640, 480};
+    params.type = mir_window_type_normal;
+
+    auto const add = mean_us(windows, [&]
+        {
+            for (int i = 0; i != windows; ++i)
+                window_manager.add_surface(clients[i / windows_per_client], params, &build_surface);
+        });
+
+    std::vector<miral::Window> all_windows;
+    tools.invoke_under_lock([&]
+        {
+            for (auto const& client : clients)
+            {
+                auto const& client_windows = tools.info_for(client).windows();
+                all_windows.insert(all_windows.end(), client_windows.begin(), client_windows.end());
+            }
+        });
+
+    int const lookup_rounds = 20;
+    auto const lookup = mean_us(lookup_rounds * windows, [&]
+        {
+            tools.invoke_under_lock([&]
+                {
+                    for (int round = 0; round != lookup_rounds; ++round)
+                    {
+                        for (auto const& window : all_windows)
+                            tools.info_for(tools.info_for(window).window().application());
+                    }
+                });
+        });
+
+    auto const modify = mean_us(windows, [&]
+        {
+            for (auto const& window : all_windows)
+            {
+                msh::SurfaceSpecification spec;
+                spec.width = window.size().width + DeltaX{1};
+                spec.height = window.size().height + DeltaY{1};
+                window_manager.modify_surface(window.application(), window, spec);
+            }
+        });
+
+    auto const remove = mean_us(windows, [&]
+        {
+            for (auto const& window : all_windows)
+                window_manager.remove_surface(window.application(), window);
+        });
+
+    std::cout << windows << ", " << add << ", " << 1000 * lookup << ", " << modify << ", " << remove << std::endl;
+}
+}
+
+int main(int argc, char** argv)
+{
+    int const max_windows = argc > 1 ? std::stoi(argv[1]) : 5000;
+
+    std::cout << "windows, add window (us), info_for window and app (ns), modify window (us), remove window (us)"
+              << std::endl;
+
+    for (int windows = max_windows / 8; windows <= max_windows; windows *= 2)
+        manage(windows);
+}
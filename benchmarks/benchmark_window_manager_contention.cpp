@@ -0,0 +1,156 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "window_manager_harness.h"
+
+#include <miral/application_info.h>
+
+#include <mir/events/event_builders.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mev = mir::events;
+namespace ms = mir::scene;
+using namespace mir::geometry;
+using namespace mir_benchmark;
+
+namespace
+{
+int const query_threads = 3;
+int const windows_per_client = 20;
+
+// Hit tests on every motion, like a policy tracking the window under the cursor
+struct HitTestingPolicy : NullInputPolicy
+{
+    using NullInputPolicy::NullInputPolicy;
+
+    bool handle_pointer_event(MirPointerEvent const* event) override
+    {
+        Point const cursor{
+            mir_pointer_event_axis_value(event, mir_pointer_axis_x),
+            mir_pointer_event_axis_value(event, mir_pointer_axis_y)};
+
+        return tools.window_at(cursor) == tools.active_window();
+    }
+};
+
+void contend(std::string const& name, bool shared_queries, std::chrono::milliseconds duration)
+{
+    WindowManagerHarness<HitTestingPolicy> harness;
+    auto& window_manager = harness.window_manager;
+    auto& tools = harness.tools;
+
+    window_manager.add_display_for_testing({{0, 0}, {1920, 1080}});
+
+    auto const client = std::make_shared<ClientSession>();
+    window_manager.add_session(client);
+
+    ms::SurfaceCreationParameters params;
+    params.size = {640, 480};
+    params.type = mir_window_type_normal;
+
+    for (int i = 0; i != windows_per_client; ++i)
+        window_manager.add_surface(client, params, &build_surface);
+
+    std::vector<mir::EventUPtr> motion;
+    for (int i = 0; i != 64; ++i)
+    {
+        motion.push_back(mev::make_event(
+            MirInputDeviceId{0}, std::chrono::nanoseconds{i}, std::vector<uint8_t>{}, mir_input_event_modifier_none,
+            mir_pointer_action_motion, 0, 30.0f*i, 16.0f*i, 0.0f, 0.0f, 1.0f, 1.0f));
+    }
+
+    std::atomic<bool> running{true};
+    std::atomic<long> pointer_events{0};
+    std::atomic<long> window_churn{0};
+    std::atomic<long> queries{0};
+
+    std::vector<std::thread> threads;
+
+    threads.emplace_back([&]
+        {
+            for (long i = 0; running; ++i)
+            {
+                auto const event = mir_input_event_get_pointer_event(mir_event_get_input_event(motion[i % motion.size()].get()));
+                window_manager.handle_pointer_event(event);
+                ++pointer_events;
+            }
+        });
+
+    threads.emplace_back([&]
+        {
+            while (running)
+            {
+                window_manager.add_surface(client, params, &build_surface);
+                window_manager.remove_surface(client, client->surfaces.rbegin()->second);
+                ++window_churn;
+            }
+        });
+
+    for (int t = 0; t != query_threads; ++t)
+    {
+        threads.emplace_back([&, t]
+            {
+                auto const query = [&]
+                    {
+                        Point const cursor{100*t, 100*t};
+                        if (auto const window = tools.window_at(cursor))
+                            tools.info_for(window);
+                        tools.active_window();
+                        tools.info_for(client).windows().size();
+                    };
+
+                while (running)
+                {
+                    if (shared_queries)
+                        tools.invoke_under_shared_lock(query);
+                    else
+                        tools.invoke_under_lock(query);
+
+                    ++queries;
+                }
+            });
+    }
+
+    std::this_thread::sleep_for(duration);
+    running = false;
+
+    for (auto& thread : threads)
+        thread.join();
+
+    auto const per_second = [&](long count) { return 1000 * count / duration.count(); };
+
+    std::cout << name << ", "
+              << per_second(queries) << ", "
+              << per_second(pointer_events) << ", "
+              << per_second(window_churn) << std::endl;
+}
+}
+
+int main(int argc, char** argv)
+{
+    std::chrono::milliseconds const duration{argc > 1 ? std::stoi(argv[1]) : 1000};
+
+    std::cout << "queries, queries/s, pointer events/s, windows added & removed/s" << std::endl;
+
+    contend("exclusive lock", false, duration);
+    contend("shared lock", true, duration);
+}
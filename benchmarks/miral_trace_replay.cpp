@@ -0,0 +1,125 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "window_manager_harness.h"
+
+#include "window_management_recorder.h"
+#include "window_management_replay.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using namespace mir::geometry;
+using namespace mir_benchmark;
+
+namespace
+{
+// Canonical window management with click to focus.
+// To reproduce a problem with another policy offline, substitute it here.
+struct ReplayPolicy : NullInputPolicy
+{
+    using NullInputPolicy::NullInputPolicy;
+
+    bool handle_pointer_event(MirPointerEvent const* event) override
+    {
+        if (mir_pointer_event_action(event) != mir_pointer_action_button_down)
+            return false;
+
+        Point const cursor{
+            mir_pointer_event_axis_value(event, mir_pointer_axis_x),
+            mir_pointer_event_axis_value(event, mir_pointer_axis_y)};
+
+        tools.select_active_window(tools.window_at(cursor));
+        return false;
+    }
+};
+
+// The replayed calls, recorded for comparison with the original trace
+std::shared_ptr<miral::TraceRecordBuffer> replayed;
+
+struct RecordingPolicy : miral::WindowManagementRecorder
+{
+    explicit RecordingPolicy(miral::WindowManagerTools const& tools) :
+        miral::WindowManagementRecorder{
+            tools,
+            [](miral::WindowManagerTools const& tools) { return std::make_unique<ReplayPolicy>(tools); },
+            replayed,
+            ""}
+    {
+    }
+};
+
+void usage(char const* program)
+{
+    std::cerr << "Usage: " << program << " --dump <trace>\n"
+              << "       " << program << " <trace> [<replayed trace>]\n"
+              << "Replays a trace recorded with --window-management-trace-file and prints the calls the policy\n"
+              << "receives when it does, to compare with \"--dump <trace>\".\n";
+}
+}
+
+int main(int argc, char** argv)
+try
+{
+    if (argc == 3 && strcmp(argv[1], "--dump") == 0)
+    {
+        miral::dump_trace(std::cout, miral::load_trace(argv[2]));
+        return 0;
+    }
+
+    if (argc < 2 || argc > 3 || argv[1][0] == '-')
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    auto const recorded = miral::load_trace(argv[1]);
+    replayed = std::make_shared<miral::TraceRecordBuffer>(2 * recorded.size() + 1);
+
+    {
+        WindowManagerHarness<RecordingPolicy> harness;
+
+        // A trace that has wrapped may have lost the outputs: assume one
+        auto const has_outputs = std::any_of(recorded.begin(), recorded.end(), [](miral::TraceRecord const& record)
+            { return record.call == miral::TraceCall::advise_output_create; });
+
+        if (!has_outputs)
+            harness.window_manager.add_display_for_testing({{0, 0}, {1920, 1080}});
+
+        miral::WindowManagementReplay replay{
+            harness.window_manager,
+            [](std::string const& name) { return std::make_shared<ClientSession>(name); },
+            [](std::shared_ptr<mir::scene::Surface> const& surface)
+                { std::static_pointer_cast<PlacedSurface>(surface)->post_frame(); }};
+
+        for (auto const& record : recorded)
+            replay.replay(record);
+    }
+
+    miral::dump_trace(std::cout, replayed->records());
+
+    if (argc == 3)
+        miral::save_trace(argv[2], replayed->records());
+
+    return 0;
+}
+catch (std::exception const& error)
+{
+    std::cerr << error.what() << std::endl;
+    return 1;
+}
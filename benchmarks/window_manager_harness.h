@@ -0,0 +1,197 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_BENCHMARK_WINDOW_MANAGER_HARNESS_H_
+#define MIR_BENCHMARK_WINDOW_MANAGER_HARNESS_H_
+
+#include "basic_window_manager.h"
+
+#include <miral/canonical_window_manager.h>
+
+#include <mir/scene/surface_creation_parameters.h>
+#include <mir/scene/surface_observer.h>
+#include <mir/shell/display_layout.h>
+#include <mir/shell/focus_controller.h>
+#include <mir/shell/persistent_surface_store.h>
+
+#include <mir/test/doubles/stub_session.h>
+#include <mir/test/doubles/stub_surface.h>
+#include <mir/test/fake_shared.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mir_benchmark
+{
+/// A miral::BasicWindowManager with null Mir collaborators, running Policy
+template<typename Policy>
+struct WindowManagerHarness
+{
+    struct NullFocusController : mir::shell::FocusController
+    {
+        void focus_next_session() override {}
+        auto focused_session() const -> std::shared_ptr<mir::scene::Session> override { return {}; }
+        void set_focus_to(
+            std::shared_ptr<mir::scene::Session> const&, std::shared_ptr<mir::scene::Surface> const&) override {}
+        auto focused_surface() const -> std::shared_ptr<mir::scene::Surface> override { return {}; }
+        void raise(mir::shell::SurfaceSet const&) override {}
+        auto surface_at(mir::geometry::Point) const -> std::shared_ptr<mir::scene::Surface> override { return {}; }
+        void set_drag_and_drop_handle(std::vector<uint8_t> const&) override {}
+        void clear_drag_and_drop_handle() override {}
+    };
+
+    struct NullDisplayLayout : mir::shell::DisplayLayout
+    {
+        void clip_to_output(mir::geometry::Rectangle&) override {}
+        void size_to_output(mir::geometry::Rectangle&) override {}
+        bool place_in_output(mir::graphics::DisplayConfigurationOutputId, mir::geometry::Rectangle&) override
+            { return false; }
+    };
+
+    struct NullPersistentSurfaceStore : mir::shell::PersistentSurfaceStore
+    {
+        Id id_for_surface(std::shared_ptr<mir::scene::Surface> const&) override { return {}; }
+        auto surface_for_id(Id const&) const -> std::shared_ptr<mir::scene::Surface> override { return {}; }
+    };
+
+    struct NullDisplayConfigurationObservers : mir::ObserverRegistrar<mir::graphics::DisplayConfigurationObserver>
+    {
+        void register_interest(std::weak_ptr<mir::graphics::DisplayConfigurationObserver> const&) override {}
+        void register_interest(
+            std::weak_ptr<mir::graphics::DisplayConfigurationObserver> const&, mir::Executor&) override {}
+        void unregister_interest(mir::graphics::DisplayConfigurationObserver const&) override {}
+    };
+
+    NullFocusController focus_controller;
+    NullDisplayLayout display_layout;
+    NullPersistentSurfaceStore persistent_surface_store;
+    NullDisplayConfigurationObservers display_configuration_observers;
+    miral::WindowManagerTools tools{nullptr};
+
+    miral::BasicWindowManager window_manager{
+        &focus_controller,
+        mir::test::fake_shared(display_layout),
+        mir::test::fake_shared(persistent_surface_store),
+        display_configuration_observers,
+        [this](miral::WindowManagerTools const& policy_tools) -> std::unique_ptr<miral::WindowManagementPolicy>
+            {
+                tools = policy_tools;
+                return std::make_unique<Policy>(policy_tools);
+            }};
+};
+
+/// Ignores input, otherwise the canonical window management
+struct NullInputPolicy : miral::CanonicalWindowManagerPolicy
+{
+    using miral::CanonicalWindowManagerPolicy::CanonicalWindowManagerPolicy;
+
+    bool handle_keyboard_event(MirKeyboardEvent const*) override { return false; }
+    bool handle_touch_event(MirTouchEvent const*) override { return false; }
+    bool handle_pointer_event(MirPointerEvent const*) override { return false; }
+    void handle_request_move(miral::WindowInfo&, MirInputEvent const*) override {}
+    void handle_request_resize(miral::WindowInfo&, MirInputEvent const*, MirResizeEdge) override {}
+};
+
+struct PlacedSurface : mir::test::doubles::StubSurface
+{
+    PlacedSurface(std::string const& name, mir::geometry::Point top_left, mir::geometry::Size size) :
+        name_{name}, top_left_{top_left}, size_{size} {}
+
+    std::string name() const override { return name_; }
+    mir::geometry::Point top_left() const override { return top_left_; }
+    void move_to(mir::geometry::Point const& top_left) override { top_left_ = top_left; }
+    mir::geometry::Size size() const override { return size_; }
+    void resize(mir::geometry::Size const& size) override { size_ = size; }
+    bool visible() const override { return true; }
+
+    void add_observer(std::shared_ptr<mir::scene::SurfaceObserver> const& observer) override
+    {
+        observers.push_back(observer);
+    }
+
+    void remove_observer(std::weak_ptr<mir::scene::SurfaceObserver> const& observer) override
+    {
+        auto const doomed = observer.lock();
+        observers.erase(std::remove(observers.begin(), observers.end(), doomed), observers.end());
+    }
+
+    /// Notifies the observers (including the window manager's) of the first frame
+    void post_frame()
+    {
+        auto const notify = observers;
+        for (auto const& observer : notify)
+            observer->frame_posted(this, 1, size_);
+    }
+
+    std::string const name_;
+    mir::geometry::Point top_left_;
+    mir::geometry::Size size_;
+    std::vector<std::shared_ptr<mir::scene::SurfaceObserver>> observers;
+};
+
+/// A session that really owns its surfaces, so windows can be added and removed
+struct ClientSession : mir::test::doubles::StubSession
+{
+    ClientSession() = default;
+    explicit ClientSession(std::string const& name) : name_{name} {}
+
+    std::string name() const override { return name_; }
+
+    mir::frontend::SurfaceId create_surface(
+        mir::scene::SurfaceCreationParameters const& params,
+        std::shared_ptr<mir::frontend::EventSink> const&) override
+    {
+        mir::frontend::SurfaceId const id{next_surface_id++};
+        auto const surface = std::make_shared<PlacedSurface>(params.name, params.top_left, params.size);
+        surfaces[id] = surface;
+        ids[surface.get()] = id;
+        return id;
+    }
+
+    std::shared_ptr<mir::scene::Surface> surface(mir::frontend::SurfaceId id) const override
+    {
+        return surfaces.at(id);
+    }
+
+    void destroy_surface(std::weak_ptr<mir::scene::Surface> const& surface) override
+    {
+        auto const id = ids.find(surface.lock().get());
+        if (id != ids.end())
+        {
+            surfaces.erase(id->second);
+            ids.erase(id);
+        }
+    }
+
+    std::string const name_;
+    int next_surface_id{0};
+    std::map<mir::frontend::SurfaceId, std::shared_ptr<mir::scene::Surface>> surfaces;
+    std::unordered_map<mir::scene::Surface const*, mir::frontend::SurfaceId> ids;
+};
+
+inline auto build_surface(
+    std::shared_ptr<mir::scene::Session> const& session, mir::scene::SurfaceCreationParameters const& params)
+-> mir::frontend::SurfaceId
+{
+    return session->create_surface(params, {});
+}
+}
+
+#endif /* MIR_BENCHMARK_WINDOW_MANAGER_HARNESS_H_ */
@@ -0,0 +1,61 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_DISPATCH_BATCHING_DISPATCHABLE_H_
+#define MIR_DISPATCH_BATCHING_DISPATCHABLE_H_
+
+#include "mir/dispatch/dispatchable.h"
+
+#include <cstddef>
+#include <memory>
+
+namespace mir
+{
+namespace dispatch
+{
+class MultiplexingDispatchable;
+
+/**
+ * \brief An adaptor whose dispatch() handles up to \p max_batch ready dispatchees of a
+ *        MultiplexingDispatchable
+ *
+ * The ready dispatchees are collected with a single wait, and each is dispatched once, so
+ * a busy thread doesn't return to its caller between each of them. Dispatchees that are
+ * still ready afterwards wait behind the others that are ready, so none is starved.
+ * A dispatchee removed from the MultiplexingDispatchable part way through a batch is not
+ * dispatched for the rest of it.
+ * \note Instances are fully thread-safe.
+ */
+class BatchingDispatchable final : public Dispatchable
+{
+public:
+    BatchingDispatchable(std::shared_ptr<MultiplexingDispatchable> const& multiplexer, std::size_t max_batch);
+
+    BatchingDispatchable& operator=(BatchingDispatchable const&) = delete;
+    BatchingDispatchable(BatchingDispatchable const&) = delete;
+
+    Fd watch_fd() const override;
+    bool dispatch(FdEvents events) override;
+    FdEvents relevant_events() const override;
+
+private:
+    std::shared_ptr<MultiplexingDispatchable> const multiplexer;
+    std::size_t const max_batch;
+};
+}
+}
+
+#endif // MIR_DISPATCH_BATCHING_DISPATCHABLE_H_
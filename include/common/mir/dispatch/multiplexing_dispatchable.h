@@ -33,6 +33,8 @@ namespace mir
 {
 namespace dispatch
 {
+class BatchingDispatchable;
+
 /**
  * \brief How concurrent dispatch should be handled
  */
@@ -95,6 +97,8 @@ public:
      */
     void remove_watch(Fd const& fd);
 private:
+    friend class BatchingDispatchable;
+
     PosixRWMutex lifetime_mutex;
     std::list<std::pair<std::shared_ptr<Dispatchable>, bool>> dispatchee_holder;
 
@@ -246,6 +246,18 @@ public:
      */
     void invoke_under_lock(std::function<void()> const& callback);
 
+    /** Multi-thread support for readers
+     *  As invoke_under_lock(), but callbacks on different threads may run concurrently with one
+     *  another (though not with any update of the model). Use this for hit testing and other
+     *  lookups that would otherwise contend with input handling and window creation.
+     *  The callback must only call the "Query" member functions:
+     *  count_applications(), info_for(), info_for_window_id(), id_for_window(), active_window(),
+     *  window_at(), for_each_workspace_containing() and for_each_window_in_workspace(); and must
+     *  not modify the info they return.
+     *  This should NOT be used by a thread that already holds the lock.
+     */
+    void invoke_under_shared_lock(std::function<void()> const& callback);
+
 private:
     WindowManagerToolsImplementation* tools;
 };
@@ -206,6 +206,26 @@ public:
 
     Display() = default;
     virtual ~Display() = default;
+
+    /**
+     * Sets a new output configuration, replacing only the DisplaySyncGroups of outputs that change.
+     *
+     * Before destroying a DisplaySyncGroup the Display calls \p removing_group with it, so its
+     * users can let go of it and its DisplayBuffers. References to every other existing group
+     * remain valid. New groups, for new or changed outputs, are visible through
+     * for_each_display_sync_group() once this returns.
+     *
+     * \param conf           [in] Configuration to possibly apply.
+     * \param removing_group [in] Called with each DisplaySyncGroup about to be destroyed.
+     * \return      \c false, with nothing applied, if the Display can only reconfigure all
+     *              outputs together through configure(). This is the default.
+     */
+    virtual bool configure_changed_outputs(
+        DisplayConfiguration const& /*conf*/,
+        std::function<void(DisplaySyncGroup&)> const& /*removing_group*/)
+    {
+        return false;
+    }
 private:
     Display(Display const&) = delete;
     Display& operator=(Display const&) = delete;
@@ -21,6 +21,7 @@
 
 namespace mir
 {
+namespace graphics { class DisplaySyncGroup; }
 namespace compositor
 {
 
@@ -32,6 +33,21 @@ public:
     virtual void start() = 0;
     virtual void stop() = 0;
 
+    /**
+     * Stops compositing to a DisplaySyncGroup that the Display is about to destroy.
+     *
+     * Compositing to other groups may continue. The default implementation stops
+     * all compositing.
+     */
+    virtual void remove_display_sync_group(graphics::DisplaySyncGroup& /*group*/) { stop(); }
+
+    /**
+     * Starts compositing to any DisplaySyncGroups added since the compositor started.
+     *
+     * The default implementation restarts all compositing.
+     */
+    virtual void add_display_sync_groups() { stop(); start(); }
+
 protected:
     Compositor() = default;
     Compositor(Compositor const&) = delete;
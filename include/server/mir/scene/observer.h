@@ -23,6 +23,7 @@
 
 namespace mir
 {
+namespace geometry { struct Rectangle; }
 namespace scene
 {
 class Surface;
@@ -52,6 +53,13 @@ protected:
     virtual ~Observer() = default;
     Observer(Observer const&) = delete;
     Observer& operator=(Observer const&) = delete;
+
+public:
+    // Used to indicate that something outside of the present surfaces (e.g. a cursor
+    // moving) has changed only within damage, so only outputs overlapping it need
+    // recomposition. By default this is treated as scene_changed().
+    // (Declared last so that the existing vtable layout is unchanged.)
+    virtual void scene_damaged(geometry::Rectangle const& /*damage*/) { scene_changed(); }
 };
 
 }
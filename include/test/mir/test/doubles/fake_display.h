@@ -52,6 +52,9 @@ public:
 
     bool apply_if_configuration_preserves_display_buffers(graphics::DisplayConfiguration const&) override;
     void configure(mir::graphics::DisplayConfiguration const&) override;
+    bool configure_changed_outputs(
+        mir::graphics::DisplayConfiguration const& conf,
+        std::function<void(mir::graphics::DisplaySyncGroup&)> const& removing_group) override;
 
     void emit_configuration_change_event(
         std::shared_ptr<mir::graphics::DisplayConfiguration> const& new_config);
@@ -61,6 +64,8 @@ public:
 private:
     std::shared_ptr<StubDisplayConfig> config;
     std::vector<std::unique_ptr<StubDisplaySyncGroup>> groups;
+    // The output each of groups was created for
+    std::vector<graphics::DisplayConfigurationOutput> group_outputs;
     Fd const wakeup_trigger;
     std::atomic<bool> handler_called;
     std::mutex mutable configuration_mutex;
@@ -0,0 +1,137 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/dispatch/batching_dispatchable.h"
+#include "mir/dispatch/multiplexing_dispatchable.h"
+#include "utils.h"
+
+#include <boost/throw_exception.hpp>
+#include <shared_mutex>
+
+#include <sys/epoll.h>
+#include <limits.h>
+#include <system_error>
+#include <stdexcept>
+#include <vector>
+
+namespace md = mir::dispatch;
+
+md::BatchingDispatchable::BatchingDispatchable(
+    std::shared_ptr<MultiplexingDispatchable> const& multiplexer,
+    std::size_t max_batch)
+    : multiplexer{multiplexer},
+      max_batch{max_batch}
+{
+    if (max_batch < 1 || max_batch > INT_MAX)
+    {
+        BOOST_THROW_EXCEPTION((std::invalid_argument{"Dispatch batch size out of range"}));
+    }
+}
+
+mir::Fd md::BatchingDispatchable::watch_fd() const
+{
+    return multiplexer->watch_fd();
+}
+
+bool md::BatchingDispatchable::dispatch(md::FdEvents events)
+{
+    if (events & md::FdEvent::error)
+    {
+        return false;
+    }
+
+    using Holder = decltype(MultiplexingDispatchable::dispatchee_holder);
+
+    std::vector<epoll_event> ready(max_batch);
+    std::vector<Holder::value_type> sources;
+
+    {
+        std::shared_lock<decltype(multiplexer->lifetime_mutex)> lock{multiplexer->lifetime_mutex};
+
+        auto result = epoll_wait(multiplexer->epoll_fd, ready.data(), static_cast<int>(max_batch), 0);
+
+        if (result < 0)
+        {
+            BOOST_THROW_EXCEPTION((std::system_error{errno,
+                                                     std::system_category(),
+                                                     "Failed to wait on fds"}));
+        }
+
+        // If there are none some other thread must have stolen the events we were woken for
+        ready.resize(result);
+        sources.reserve(result);
+
+        for (auto const& event : ready)
+        {
+            sources.push_back(*reinterpret_cast<Holder::pointer>(event.data.ptr));
+        }
+    }
+
+    /*
+     * Dispatching one source may remove another, for example when an input device is
+     * unplugged. Modifying a removed fd's watch fails, so probe with the events it
+     * is waiting for already: none for a disarmed one-shot source.
+     */
+    auto const still_watched = [this](epoll_event const& event, Holder::value_type const& source)
+        {
+            epoll_event probe = event;
+            probe.events = EPOLLONESHOT;
+            if (!source.second)
+                probe.events = fd_event_to_epoll(source.first->relevant_events());
+            return epoll_ctl(multiplexer->epoll_fd, EPOLL_CTL_MOD, source.first->watch_fd(), &probe) == 0;
+        };
+
+    auto const rearm = [this](epoll_event& event, Holder::value_type const& source)
+        {
+            event.events = fd_event_to_epoll(source.first->relevant_events()) | EPOLLONESHOT;
+            epoll_ctl(multiplexer->epoll_fd, EPOLL_CTL_MOD, source.first->watch_fd(), &event);
+        };
+
+    for (auto i = 0u; i != sources.size(); ++i)
+    {
+        if (i != 0 && !still_watched(ready[i], sources[i]))
+            continue;
+
+        try
+        {
+            if (!sources[i].first->dispatch(epoll_to_fd_event(ready[i])))
+            {
+                multiplexer->remove_watch(sources[i].first);
+            }
+            else if (sources[i].second)
+            {
+                rearm(ready[i], sources[i]);
+            }
+        }
+        catch (...)
+        {
+            // The rest of the batch won't be dispatched, so don't leave them disarmed
+            for (auto j = i + 1; j != sources.size(); ++j)
+            {
+                if (sources[j].second)
+                    rearm(ready[j], sources[j]);
+            }
+            throw;
+        }
+    }
+
+    return true;
+}
+
+md::FdEvents md::BatchingDispatchable::relevant_events() const
+{
+    return md::FdEvent::readable;
+}
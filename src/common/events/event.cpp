@@ -35,10 +35,17 @@
 #include "mir/events/surface_placement_event.h"
 
 #include <capnp/serialize.h>
+#include <kj/io.h>
 
 
 namespace ml = mir::logging;
 
+namespace
+{
+// Room for the (empty) root a MirEvent allocates on construction
+unsigned int const root_allocation_words{16};
+}
+
 MirEvent::MirEvent(MirEvent const& e)
 {
     auto reader = e.event.asReader();
@@ -54,13 +61,21 @@ MirEvent& MirEvent::operator=(MirEvent const& e)
     return *this;
 }
 
+MirEvent::MirEvent(unsigned int first_segment_words) :
+    message{first_segment_words}
+{
+}
+
 // TODO Look at replacing the surface event serializer with a capnproto layer
 mir::EventUPtr MirEvent::deserialize(std::string const& bytes)
 {
-    auto e = mir::EventUPtr(new MirEvent, [](MirEvent* ev) { delete ev; });
     kj::ArrayPtr<::capnp::word const> words(reinterpret_cast<::capnp::word const*>(
         bytes.data()), bytes.size() / sizeof(::capnp::word));
 
+    // Size the first segment so the copy below needs no further allocation
+    auto const first_segment_words = static_cast<unsigned int>(words.size()) + root_allocation_words;
+    auto e = mir::EventUPtr(new MirEvent{first_segment_words}, [](MirEvent* ev) { delete ev; });
+
     initMessageBuilderFromFlatArrayCopy(words, e->message);
     e->event = e->message.getRoot<mir::capnp::Event>();
 
@@ -70,9 +85,18 @@ mir::EventUPtr MirEvent::deserialize(std::string const& bytes)
 std::string MirEvent::serialize(MirEvent const* event)
 {
     std::string output;
-    auto flat_event = ::capnp::messageToFlatArray(const_cast<MirEvent*>(event)->message);
+    serialize(event, output);
+    return output;
+}
+
+void MirEvent::serialize(MirEvent const* event, std::string& output)
+{
+    auto& message = const_cast<MirEvent*>(event)->message;
+
+    output.resize(::capnp::computeSerializedSizeInWords(message) * sizeof(::capnp::word));
 
-    return {reinterpret_cast<char*>(flat_event.asBytes().begin()), flat_event.asBytes().size()};
+    kj::ArrayOutputStream stream{kj::arrayPtr(reinterpret_cast<kj::byte*>(&output[0]), output.size())};
+    ::capnp::writeMessage(stream, message);
 }
 
 MirEventType MirEvent::type() const
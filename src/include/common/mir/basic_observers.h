@@ -19,15 +19,185 @@
 #ifndef MIR_BASIC_OBSERVERS_H_
 #define MIR_BASIC_OBSERVERS_H_
 
-#include "mir/thread_safe_list.h"
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace mir
 {
+/*
+ * Notifications are far more frequent than registration changes, so the
+ * observers are held in an immutable list that add() and remove() replace,
+ * read-copy-update style. for_each() reads the list without taking any lock:
+ * it only counts itself in and out, so that a replaced list is freed once no
+ * reader can still be using it.
+ *
+ * Each entry also counts the calls in progress to it. remove() waits for those
+ * on other threads to finish, and once it returns the observer won't be called
+ * again. An observer can remove itself (or be removed) from within its own
+ * callback without deadlocking.
+ */
 template<class Observer>
-class BasicObservers : protected ThreadSafeList<std::shared_ptr<Observer>>
+class BasicObservers
 {
+protected:
+    BasicObservers() = default;
+    ~BasicObservers() { delete entries.load(); }
+
+    void add(std::shared_ptr<Observer> const& observer);
+    void remove(std::shared_ptr<Observer> const& observer);
+
+    template<typename Callback>
+    void for_each(Callback const& callback) const;
+
+private:
+    BasicObservers(BasicObservers const&) = delete;
+    BasicObservers& operator=(BasicObservers const&) = delete;
+
+    struct Entry
+    {
+        explicit Entry(std::shared_ptr<Observer> const& observer) : observer{observer} {}
+
+        std::shared_ptr<Observer> const observer;
+        std::atomic<bool> removed{false};
+        std::atomic<int> calls{0};
+    };
+
+    using Entries = std::vector<std::shared_ptr<Entry>>;
+
+    // The calls in progress on this thread, innermost first
+    struct Call
+    {
+        Entry const* entry;
+        Call const* outer;
+    };
+    static Call const*& calls_on_this_thread()
+    {
+        static thread_local Call const* calls{nullptr};
+        return calls;
+    }
+
+    void publish(std::unique_ptr<Entries const> updated);
+    void free_retired_if_unread() const;    ///< Requires mutex to be held
+
+    std::mutex mutable mutex;       ///< Serializes add() and remove(), and guards retired
+    std::atomic<Entries const*> entries{new Entries};
+    std::atomic<int> mutable readers{0};
+    std::vector<std::unique_ptr<Entries const>> mutable retired;
+    std::atomic<bool> mutable have_retired{false};
 };
+
+template<class Observer>
+void BasicObservers<Observer>::add(std::shared_ptr<Observer> const& observer)
+{
+    if (!observer) return;
+
+    std::lock_guard<decltype(mutex)> lock{mutex};
+
+    std::unique_ptr<Entries> updated{new Entries(*entries.load())};
+    updated->push_back(std::make_shared<Entry>(observer));
+
+    publish(std::move(updated));
+}
+
+template<class Observer>
+void BasicObservers<Observer>::remove(std::shared_ptr<Observer> const& observer)
+{
+    std::shared_ptr<Entry> removed_entry;
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+
+        auto const current = entries.load();
+        auto const match = std::find_if(current->begin(), current->end(),
+            [&](std::shared_ptr<Entry> const& entry) { return entry->observer == observer; });
+
+        if (match == current->end()) return;
+
+        removed_entry = *match;
+        removed_entry->removed = true;
+
+        std::unique_ptr<Entries> updated{new Entries(*current)};
+        updated->erase(updated->begin() + (match - current->begin()));
+
+        publish(std::move(updated));
+    }
+
+    // Calls through older lists see the entry is removed and skip it. Wait for the
+    // calls already in progress, except this thread's own (but not holding the
+    // mutex, which a callback may need)
+    auto own_calls = 0;
+    for (auto call = calls_on_this_thread(); call; call = call->outer)
+    {
+        if (call->entry == removed_entry.get()) ++own_calls;
+    }
+
+    while (removed_entry->calls > own_calls)
+        std::this_thread::yield();
+}
+
+template<class Observer>
+template<typename Callback>
+void BasicObservers<Observer>::for_each(Callback const& callback) const
+{
+    struct Reading
+    {
+        explicit Reading(BasicObservers const& self) : self(self) { ++self.readers; }
+        ~Reading()
+        {
+            if (--self.readers == 0 && self.have_retired)
+            {
+                // If add() or remove() holds the mutex it will free them instead
+                std::unique_lock<decltype(self.mutex)> lock{self.mutex, std::try_to_lock};
+                if (lock.owns_lock()) self.free_retired_if_unread();
+            }
+        }
+        BasicObservers const& self;
+    } const reading{*this};
+
+    for (auto const& entry : *entries.load())
+    {
+        struct Calling
+        {
+            explicit Calling(Entry& entry) : entry(entry), call{&entry, calls_on_this_thread()}
+            {
+                ++entry.calls;
+                calls_on_this_thread() = &call;
+            }
+            ~Calling()
+            {
+                calls_on_this_thread() = call.outer;
+                --entry.calls;
+            }
+            Entry& entry;
+            Call const call;
+        } const calling{*entry};
+
+        if (!entry->removed) callback(entry->observer);
+    }
+}
+
+template<class Observer>
+void BasicObservers<Observer>::publish(std::unique_ptr<Entries const> updated)
+{
+    retired.emplace_back(entries.exchange(updated.release()));
+    have_retired = true;
+
+    free_retired_if_unread();
+}
+
+template<class Observer>
+void BasicObservers<Observer>::free_retired_if_unread() const
+{
+    // A reader counted in after this check loads the current list, never a retired one
+    if (readers == 0)
+    {
+        retired.clear();
+        have_retired = false;
+    }
+}
 }
 
 #endif /* MIR_BASIC_OBSERVERS_H_ */
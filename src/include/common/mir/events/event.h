@@ -73,6 +73,12 @@ struct MirEvent
     static mir::EventUPtr deserialize(std::string const& bytes);
     static std::string serialize(MirEvent const* event);
 
+    /// Serializes into output (replacing its contents), reusing its storage where possible
+    static void serialize(MirEvent const* event, std::string& output);
+
+private:
+    explicit MirEvent(unsigned int first_segment_words);
+
 protected:
     MirEvent() = default;
 
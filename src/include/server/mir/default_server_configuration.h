@@ -455,6 +455,8 @@ protected:
 private:
     std::shared_ptr<options::Configuration> const configuration_options;
     std::shared_ptr<input::EventFilter> default_filter;
+    // Whether the_pixel_buffer() was made by the default implementation
+    bool default_pixel_buffer{false};
     CachedPtr<ObserverMultiplexer<graphics::DisplayConfigurationObserver>>
         display_configuration_observer_multiplexer;
     CachedPtr<ObserverMultiplexer<input::SeatObserver>>
@@ -0,0 +1,65 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_EGL_SYNC_FENCE_H_
+#define MIR_GRAPHICS_EGL_SYNC_FENCE_H_
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace mir
+{
+namespace graphics
+{
+
+/**
+ * A fence in the command stream of the current GL context.
+ *
+ * When EGL_KHR_fence_sync is unavailable raising the fence falls back
+ * to glFinish() and waiting on it is a no-op.
+ */
+class EGLSyncFence
+{
+public:
+    EGLSyncFence();
+    ~EGLSyncFence() noexcept;
+
+    /// Replaces any pending fence with one after the commands issued so far
+    /// and flushes them. Must be called with a current context.
+    void raise();
+
+    /// Blocks until the GPU has passed the last raised fence.
+    void wait();
+
+private:
+    EGLSyncFence(EGLSyncFence const&) = delete;
+    EGLSyncFence& operator=(EGLSyncFence const&) = delete;
+
+    void reset();
+
+    PFNEGLCREATESYNCKHRPROC eglCreateSyncKHR;
+    PFNEGLDESTROYSYNCKHRPROC eglDestroySyncKHR;
+    PFNEGLCLIENTWAITSYNCKHRPROC eglClientWaitSyncKHR;
+
+    enum class Support { unknown, supported, unsupported } support;
+    EGLDisplay display;
+    EGLSyncKHR sync;
+};
+
+}
+}
+
+#endif /* MIR_GRAPHICS_EGL_SYNC_FENCE_H_ */
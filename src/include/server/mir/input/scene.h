@@ -25,6 +25,10 @@
 
 namespace mir
 {
+namespace geometry
+{
+struct Rectangle;
+}
 namespace scene
 {
 class Observer;
@@ -59,6 +63,11 @@ public:
     // TODO: How can something like SurfaceObserver be adapted to work with non surface renderables?
     virtual void emit_scene_changed() = 0;
 
+    // Cheaper than emit_scene_changed() when an input visualization has only changed
+    // within damage: only outputs overlapping it need recomposition. By default this
+    // is treated as emit_scene_changed().
+    virtual void emit_scene_damaged(geometry::Rectangle const& /*damage*/) { emit_scene_changed(); }
+
 protected:
     Scene() = default;
     Scene(Scene const&) = delete;
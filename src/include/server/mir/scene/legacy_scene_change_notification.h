@@ -53,6 +53,7 @@ public:
     void surfaces_reordered() override;
     
     void scene_changed() override;
+    void scene_damaged(geometry::Rectangle const& damage) override;
 
     void surface_exists(Surface* surface) override;
     void end_observation() override;
@@ -31,6 +31,7 @@
 #include <boost/throw_exception.hpp>
 
 #include <algorithm>
+#include <shared_mutex>
 
 using namespace mir;
 using namespace mir::geometry;
@@ -49,7 +50,7 @@ struct miral::BasicWindowManager::Locker
         policy->advise_end();
     }
 
-    std::lock_guard<std::mutex> const lock;
+    std::lock_guard<mir::PosixRWMutex> const lock;
     WindowManagementPolicy* const policy;
 };
 
@@ -78,6 +79,7 @@ miral::BasicWindowManager::BasicWindowManager(
     display_layout(display_layout),
     persistent_surface_store{persistent_surface_store},
     policy(build(WindowManagerTools{this})),
+    mutex{mir::PosixRWMutex::Type::PreferWriterNonRecursive},
     display_config_monitor{std::make_shared<DisplayConfigurationListeners>()}
 {
     display_config_monitor->add_listener(this);
@@ -94,14 +96,14 @@ miral::BasicWindowManager::~BasicWindowManager()
 void miral::BasicWindowManager::add_session(std::shared_ptr<scene::Session> const& session)
 {
     Locker lock{this};
-    policy->advise_new_app(app_info[session] = ApplicationInfo(session));
+    policy->advise_new_app(app_info[session.get()] = ApplicationInfo(session));
 }
 
 void miral::BasicWindowManager::remove_session(std::shared_ptr<scene::Session> const& session)
 {
     Locker lock{this};
-    policy->advise_delete_app(app_info[session]);
-    app_info.erase(session);
+    policy->advise_delete_app(app_info[session.get()]);
+    app_info.erase(session.get());
 }
 
 auto miral::BasicWindowManager::add_surface(
@@ -118,8 +120,9 @@ auto miral::BasicWindowManager::add_surface(
     scene::SurfaceCreationParameters parameters;
     spec.update(parameters);
     auto const surface_id = build(session, parameters);
-    Window const window{session, session->surface(surface_id)};
-    auto& window_info = this->window_info.emplace(window, WindowInfo{window, spec}).first->second;
+    auto const surface = session->surface(surface_id);
+    Window const window{session, surface};
+    auto& window_info = this->window_info.emplace(surface.get(), WindowInfo{window, spec}).first->second;
 
     if (spec.parent().is_set() && spec.parent().value().lock())
         window_info.parent(info_for(spec.parent().value()).window());
@@ -202,6 +205,8 @@ void miral::BasicWindowManager::remove_surface(
 
 void miral::BasicWindowManager::remove_window(Application const& application, miral::WindowInfo const& info)
 {
+    // The key outlives the surface: destroy_surface() may release the last reference before erase()
+    scene::Surface const* const surface = std::shared_ptr<scene::Surface>(info.window()).get();
     bool const is_active_window{mru_active_windows.top() == info.window()};
     auto const workspaces_containing_window = workspaces_containing(info.window());
 
@@ -227,7 +232,7 @@ void miral::BasicWindowManager::remove_window(Application const& application, mi
 
     // NB erase() invalidates info, but we want to keep access to "parent".
     auto const parent = info.parent();
-    erase(info);
+    erase(surface, info);
 
     if (is_active_window)
     {
@@ -293,7 +298,7 @@ void miral::BasicWindowManager::refocus(
     focus_next_application();
 }
 
-void miral::BasicWindowManager::erase(miral::WindowInfo const& info)
+void miral::BasicWindowManager::erase(scene::Surface const* surface, miral::WindowInfo const& info)
 {
     if (auto const parent = info.parent())
         info_for(parent).remove_child(info.window());
@@ -301,7 +306,7 @@ void miral::BasicWindowManager::erase(miral::WindowInfo const& info)
     for (auto& child : info.children())
         info_for(child).parent({});
 
-    window_info.erase(info.window());
+    window_info.erase(surface);
 }
 
 #pragma GCC diagnostic push
@@ -470,7 +475,7 @@ auto miral::BasicWindowManager::find_application(std::function<bool(ApplicationI
     {
         if (predicate(info.second))
         {
-            return Application{info.first};
+            return info.second.application();
         }
     }
 
@@ -480,19 +485,19 @@ auto miral::BasicWindowManager::find_application(std::function<bool(ApplicationI
 auto miral::BasicWindowManager::info_for(std::weak_ptr<scene::Session> const& session) const
 -> ApplicationInfo&
 {
-    return const_cast<ApplicationInfo&>(app_info.at(session));
+    return const_cast<ApplicationInfo&>(app_info.at(session.lock().get()));
 }
 
 auto miral::BasicWindowManager::info_for(std::weak_ptr<scene::Surface> const& surface) const
 -> WindowInfo&
 {
-    return const_cast<WindowInfo&>(window_info.at(surface));
+    return const_cast<WindowInfo&>(window_info.at(surface.lock().get()));
 }
 
 auto miral::BasicWindowManager::info_for(Window const& window) const
 -> WindowInfo&
 {
-    return info_for(std::weak_ptr<mir::scene::Surface>(window));
+    return const_cast<WindowInfo&>(window_info.at(std::shared_ptr<mir::scene::Surface>(window).get()));
 }
 
 void miral::BasicWindowManager::ask_client_to_close(Window const& window)
@@ -1246,6 +1251,13 @@ void miral::BasicWindowManager::invoke_under_lock(std::function<void()> const& c
     callback();
 }
 
+void miral::BasicWindowManager::invoke_under_shared_lock(std::function<void()> const& callback)
+{
+    // Nothing changes, so there's nothing to advise the policy of (and no dead workspaces to reap)
+    std::shared_lock<decltype(mutex)> lock{mutex};
+    callback();
+}
+
 auto miral::BasicWindowManager::select_active_window(Window const& hint) -> miral::Window
 {
     auto const prev_window = active_window();
@@ -30,6 +30,7 @@
 
 #include <mir/geometry/rectangles.h>
 #include <mir/observer_registrar.h>
+#include <mir/posix_rw_mutex.h>
 #include <mir/shell/abstract_shell.h>
 #include <mir/shell/window_manager.h>
 
@@ -38,6 +39,7 @@
 
 #include <map>
 #include <mutex>
+#include <unordered_map>
 
 namespace mir
 {
@@ -194,10 +196,16 @@ public:
     void place_and_size_for_state(WindowSpecification& modifications, WindowInfo const& window_info) const override;
 
     void invoke_under_lock(std::function<void()> const& callback) override;
+    void invoke_under_shared_lock(std::function<void()> const& callback) override;
 
 private:
-    using SurfaceInfoMap = std::map<std::weak_ptr<mir::scene::Surface>, WindowInfo, std::owner_less<std::weak_ptr<mir::scene::Surface>>>;
-    using SessionInfoMap = std::map<std::weak_ptr<mir::scene::Session>, ApplicationInfo, std::owner_less<std::weak_ptr<mir::scene::Session>>>;
+    // Replays output changes through the ActiveOutputsListener interface
+    friend class WindowManagementReplay;
+
+    // Keyed by address: the info holds the weak_ptr, and node-based storage keeps the info references
+    // handed to the policy valid while other windows come and go.
+    using SurfaceInfoMap = std::unordered_map<mir::scene::Surface const*, WindowInfo>;
+    using SessionInfoMap = std::unordered_map<mir::scene::Session const*, ApplicationInfo>;
 
     mir::shell::FocusController* const focus_controller;
     std::shared_ptr<mir::shell::DisplayLayout> const display_layout;
@@ -214,7 +222,9 @@ private:
 
     std::unique_ptr<WindowManagementPolicy> const policy;
 
-    std::mutex mutex;
+    // Held exclusively (by Locker) around every call into the policy, shared by read-only queries.
+    // Prefers writers so a steady stream of queries can't starve updates to the model.
+    mir::PosixRWMutex mutex;
     SessionInfoMap app_info;
     SurfaceInfoMap window_info;
     mir::geometry::Rectangles outputs;
@@ -251,7 +261,7 @@ private:
         -> mir::optional_value<Rectangle>;
 
     void move_tree(miral::WindowInfo& root, mir::geometry::Displacement movement);
-    void erase(miral::WindowInfo const& info);
+    void erase(mir::scene::Surface const* surface, miral::WindowInfo const& info);
     void validate_modification_request(WindowSpecification const& modifications, WindowInfo const& window_info) const;
     void place_and_size(WindowInfo& root, Point const& new_pos, Size const& new_size);
     void set_state(miral::WindowInfo& window_info, MirWindowState value);
@@ -18,6 +18,7 @@
 
 #include "miral/set_window_management_policy.h"
 #include "basic_window_manager.h"
+#include "window_management_recorder.h"
 #include "window_management_trace.h"
 
 #include <mir/server.h>
@@ -28,6 +29,7 @@ namespace msh = mir::shell;
 namespace
 {
 char const* const trace_option = "window-management-trace";
+char const* const trace_file_option = "window-management-trace-file";
 }
 
 miral::SetWindowManagementPolicy::SetWindowManagementPolicy(WindowManagementPolicyBuilder const& builder) :
@@ -40,6 +42,8 @@ miral::SetWindowManagementPolicy::~SetWindowManagementPolicy() = default;
 void miral::SetWindowManagementPolicy::operator()(mir::Server& server) const
 {
     server.add_configuration_option(trace_option, "log trace message", mir::OptionType::null);
+    server.add_configuration_option(
+        trace_file_option, "record a binary trace to the given file on exit", mir::OptionType::string);
 
     server.override_the_window_manager_builder([this, &server](msh::FocusController* focus_controller)
         -> std::shared_ptr<msh::WindowManager>
@@ -48,19 +52,25 @@ void miral::SetWindowManagementPolicy::operator()(mir::Server& server) const
 
             auto const persistent_surface_store = server.the_persistent_surface_store();
 
-            if (server.get_options()->is_set(trace_option))
+            auto policy_builder = builder;
+
+            if (server.get_options()->is_set(trace_file_option))
             {
-                auto trace_builder = [this](WindowManagerTools const& tools) -> std::unique_ptr<miral::WindowManagementPolicy>
+                auto const trace_file = server.get_options()->get<std::string>(trace_file_option);
+                policy_builder = [policy_builder, trace_file](WindowManagerTools const& tools) -> std::unique_ptr<miral::WindowManagementPolicy>
                     {
-                        return std::make_unique<WindowManagementTrace>(tools, builder);
+                        return std::make_unique<WindowManagementRecorder>(
+                            tools, policy_builder, std::make_shared<TraceRecordBuffer>(), trace_file);
                     };
+            }
 
-                return std::make_shared<BasicWindowManager>(
-                    focus_controller,
-                    display_layout,
-                    persistent_surface_store,
-                    *server.the_display_configuration_observer_registrar(),
-                    trace_builder);
+            // With both traces, the logged calls are those made to the recorder
+            if (server.get_options()->is_set(trace_option))
+            {
+                policy_builder = [policy_builder](WindowManagerTools const& tools) -> std::unique_ptr<miral::WindowManagementPolicy>
+                    {
+                        return std::make_unique<WindowManagementTrace>(tools, policy_builder);
+                    };
             }
 
             return std::make_shared<BasicWindowManager>(
@@ -68,6 +78,6 @@ void miral::SetWindowManagementPolicy::operator()(mir::Server& server) const
                 display_layout,
                 persistent_surface_store,
                 *server.the_display_configuration_observer_registrar(),
-                builder);
+                policy_builder);
         });
 }
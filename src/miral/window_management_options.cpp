@@ -19,6 +19,7 @@
 #include "miral/window_management_options.h"
 
 #include "basic_window_manager.h"
+#include "window_management_recorder.h"
 #include "window_management_trace.h"
 
 #include <mir/abnormal_exit.h>
@@ -34,6 +35,7 @@ namespace
 char const* const wm_option = "window-manager";
 char const* const wm_system_compositor = "system-compositor";
 char const* const trace_option = "window-management-trace";
+char const* const trace_file_option = "window-management-trace-file";
 }
 
 void miral::WindowManagerOptions::operator()(mir::Server& server) const
@@ -47,6 +49,8 @@ void miral::WindowManagerOptions::operator()(mir::Server& server) const
 
     server.add_configuration_option(wm_option, description, policies.begin()->name);
     server.add_configuration_option(trace_option, "log trace message", mir::OptionType::null);
+    server.add_configuration_option(
+        trace_file_option, "record a binary trace to the given file on exit", mir::OptionType::string);
 
     server.override_the_window_manager_builder([this, &server](msh::FocusController* focus_controller)
         -> std::shared_ptr<msh::WindowManager>
@@ -61,19 +65,25 @@ void miral::WindowManagerOptions::operator()(mir::Server& server) const
             {
                 if (selection == option.name)
                 {
-                    if (server.get_options()->is_set(trace_option))
+                    auto policy_builder = option.build;
+
+                    if (options->is_set(trace_file_option))
                     {
-                        auto trace_builder = [&option](WindowManagerTools const& tools) -> std::unique_ptr<miral::WindowManagementPolicy>
+                        auto const trace_file = options->get<std::string>(trace_file_option);
+                        policy_builder = [policy_builder, trace_file](WindowManagerTools const& tools) -> std::unique_ptr<miral::WindowManagementPolicy>
                             {
-                                return std::make_unique<WindowManagementTrace>(tools, option.build);
+                                return std::make_unique<WindowManagementRecorder>(
+                                    tools, policy_builder, std::make_shared<TraceRecordBuffer>(), trace_file);
                             };
+                    }
 
-                        return std::make_shared<BasicWindowManager>(
-                            focus_controller,
-                            display_layout,
-                            persistent_surface_store,
-                            *server.the_display_configuration_observer_registrar(),
-                            trace_builder);
+                    // With both traces, the logged calls are those made to the recorder
+                    if (options->is_set(trace_option))
+                    {
+                        policy_builder = [policy_builder](WindowManagerTools const& tools) -> std::unique_ptr<miral::WindowManagementPolicy>
+                            {
+                                return std::make_unique<WindowManagementTrace>(tools, policy_builder);
+                            };
                     }
 
                     return std::make_shared<BasicWindowManager>
@@ -81,7 +91,7 @@ void miral::WindowManagerOptions::operator()(mir::Server& server) const
                          display_layout,
                          persistent_surface_store,
                          *server.the_display_configuration_observer_registrar(),
-                         option.build);
+                         policy_builder);
                 }
             }
 
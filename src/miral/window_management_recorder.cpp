@@ -0,0 +1,763 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "window_management_recorder.h"
+
+#include <miral/application_info.h>
+#include <miral/output.h>
+#include <miral/window_info.h>
+
+#include <mir/event_printer.h>
+#include <mir/scene/surface.h>
+
+#include <boost/throw_exception.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#define MIR_LOG_COMPONENT "miral::Window Management"
+#include <mir/log.h>
+
+using mir::operator<<;
+
+static_assert(sizeof(miral::TraceRecord) == 56, "TraceRecords are saved to trace files as they are");
+
+namespace
+{
+char const trace_magic[8] = {'M', 'i', 'r', 'a', 'l', 'W', 'M', '1'};
+
+struct TraceFileHeader
+{
+    char magic[8];
+    std::uint32_t record_size;
+    std::uint32_t record_count;
+};
+
+auto now() -> std::int64_t
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+auto id_of(miral::Window const& window) -> std::uint64_t
+{
+    return reinterpret_cast<std::uintptr_t>(std::shared_ptr<mir::scene::Surface>(window).get());
+}
+
+auto id_of(miral::Application const& application) -> std::uint64_t
+{
+    return reinterpret_cast<std::uintptr_t>(application.get());
+}
+
+auto make_record(std::int64_t time, miral::TraceCall call, std::uint64_t subject, std::uint64_t object)
+-> miral::TraceRecord
+{
+    miral::TraceRecord result;
+    std::memset(&result, 0, sizeof result);
+    result.time = time;
+    result.call = call;
+    result.subject = subject;
+    result.object = object;
+    return result;
+}
+
+void set_name(miral::TraceRecord& record, std::string const& name)
+{
+    std::strncpy(record.name, name.c_str(), sizeof record.name - 1);
+}
+
+void set_rect(miral::TraceRecord& record, mir::geometry::Rectangle const& rect)
+{
+    record.rect = {
+        rect.top_left.x.as_int(), rect.top_left.y.as_int(), rect.size.width.as_int(), rect.size.height.as_int()};
+}
+
+auto input_time(MirInputEvent const* event) -> std::int64_t
+{
+    return mir_input_event_get_event_time(event);
+}
+
+auto call_name(miral::TraceCall call) -> char const*
+{
+    using miral::TraceCall;
+
+    switch (call)
+    {
+#define CASE(name) case TraceCall::name: return #name;
+    CASE(window_name)
+    CASE(window_parent)
+    CASE(place_new_window)
+    CASE(handle_window_ready)
+    CASE(handle_modify_window)
+    CASE(handle_raise_window)
+    CASE(handle_keyboard_event)
+    CASE(handle_touch_event)
+    CASE(handle_pointer_event)
+    CASE(handle_request_drag_and_drop)
+    CASE(handle_request_move)
+    CASE(handle_request_resize)
+    CASE(confirm_inherited_move)
+    CASE(confirm_placement_on_display)
+    CASE(advise_new_app)
+    CASE(advise_delete_app)
+    CASE(advise_new_window)
+    CASE(advise_focus_lost)
+    CASE(advise_focus_gained)
+    CASE(advise_state_change)
+    CASE(advise_move_to)
+    CASE(advise_resize)
+    CASE(advise_delete_window)
+    CASE(advise_raise)
+    CASE(advise_output_create)
+    CASE(advise_output_update)
+    CASE(advise_output_delete)
+    CASE(advise_adding_to_workspace)
+    CASE(advise_removing_from_workspace)
+#undef CASE
+    }
+
+    return "(unknown)";
+}
+
+// Formatting is only done here, when the trace is dumped
+class TraceFormatter
+{
+public:
+    explicit TraceFormatter(std::ostream& out) : out{out} {}
+
+    void format(miral::TraceRecord const& record)
+    {
+        using miral::TraceCall;
+
+        out << std::setw(16) << record.time << ' ' << call_name(record.call);
+
+        switch (record.call)
+        {
+        case TraceCall::window_name:
+            if (record.subject)
+            {
+                windows[record.subject] = record.name;
+                out << " window=" << record.name;
+            }
+            else
+            {
+                out << " name=" << record.name;
+            }
+            break;
+
+        case TraceCall::window_parent:
+            out << " parent=" << window(record.object);
+            break;
+
+        case TraceCall::place_new_window:
+            out << " application=" << application(record.subject);
+            fields(record);
+            break;
+
+        case TraceCall::handle_modify_window:
+            out << " window=" << window(record.subject);
+            fields(record);
+            break;
+
+        case TraceCall::handle_keyboard_event:
+            out << " action=" << MirKeyboardAction(record.detail)
+                << " code=" << record.subject << " scan=" << record.object
+                << std::hex << " modifiers=" << record.extra << std::dec;
+            break;
+
+        case TraceCall::handle_touch_event:
+            out << " id=" << record.subject << " action=" << MirTouchAction(record.detail)
+                << " tool=" << MirTouchTooltype(record.object >> 32)
+                << " point=" << (record.object & 0xffff) << '/' << ((record.object >> 16) & 0xffff)
+                << " x=" << record.axis[0] << " y=" << record.axis[1]
+                << std::hex << " modifiers=" << record.extra << std::dec;
+            break;
+
+        case TraceCall::handle_pointer_event:
+            out << " action=" << MirPointerAction(record.detail) << " button_state=" << record.extra
+                << " x=" << record.axis[0] << " y=" << record.axis[1]
+                << " dx=" << record.axis[4] << " dy=" << record.axis[5]
+                << " vscroll=" << record.axis[3] << " hscroll=" << record.axis[2]
+                << std::hex << " modifiers=" << record.object << std::dec;
+            break;
+
+        case TraceCall::handle_request_resize:
+            out << " window=" << window(record.subject) << " edge=0x" << std::hex << record.detail << std::dec;
+            break;
+
+        case TraceCall::advise_new_app:
+            applications[record.subject] = record.name;
+            out << " application=" << record.name;
+            break;
+
+        case TraceCall::advise_delete_app:
+            out << " application=" << application(record.subject);
+            applications.erase(record.subject);
+            break;
+
+        case TraceCall::advise_new_window:
+            out << " window=" << window(record.subject) << " application=" << application(record.object)
+                << " type=" << MirWindowType(record.detail) << " state=" << MirWindowState(record.extra)
+                << " placement=" << rect(record);
+            break;
+
+        case TraceCall::advise_delete_window:
+            out << " window=" << window(record.subject);
+            windows.erase(record.subject);
+            break;
+
+        case TraceCall::advise_state_change:
+            out << " window=" << window(record.subject) << " state=" << MirWindowState(record.detail);
+            break;
+
+        case TraceCall::advise_move_to:
+            out << " window=" << window(record.subject) << " top_left=" << rect(record).top_left;
+            break;
+
+        case TraceCall::advise_resize:
+            out << " window=" << window(record.subject) << " new_size=" << rect(record).size;
+            break;
+
+        case TraceCall::confirm_inherited_move:
+        case TraceCall::confirm_placement_on_display:
+            out << " window=" << window(record.subject) << " -> " << rect(record);
+            break;
+
+        case TraceCall::advise_output_create:
+        case TraceCall::advise_output_delete:
+            out << " output=" << rect(record);
+            break;
+
+        case TraceCall::advise_output_update:
+            out << " updated=" << rect(record) << " original=" << original_output(record);
+            break;
+
+        case TraceCall::advise_adding_to_workspace:
+        case TraceCall::advise_removing_from_workspace:
+            out << " workspace=0x" << std::hex << record.object << std::dec << " window=" << window(record.subject);
+            break;
+
+        default:
+            out << " window=" << window(record.subject);
+            break;
+        }
+
+        out << '\n';
+    }
+
+private:
+    std::ostream& out;
+    std::unordered_map<std::uint64_t, std::string> windows;
+    std::unordered_map<std::uint64_t, std::string> applications;
+
+    static auto lookup(std::unordered_map<std::uint64_t, std::string> const& names, std::uint64_t id) -> std::string
+    {
+        auto const name = names.find(id);
+        if (name != names.end() && !name->second.empty())
+            return name->second;
+
+        std::ostringstream unnamed;
+        unnamed << "0x" << std::hex << id;
+        return unnamed.str();
+    }
+
+    auto window(std::uint64_t id) const -> std::string { return lookup(windows, id); }
+    auto application(std::uint64_t id) const -> std::string { return lookup(applications, id); }
+
+    static auto rect(miral::TraceRecord const& record) -> mir::geometry::Rectangle
+    {
+        return {{record.rect.x, record.rect.y}, {record.rect.width, record.rect.height}};
+    }
+
+    static auto original_output(miral::TraceRecord const& record) -> mir::geometry::Rectangle
+    {
+        return {
+            {std::int32_t(record.subject >> 32), std::int32_t(record.subject)},
+            {std::int32_t(record.object >> 32), std::int32_t(record.object)}};
+    }
+
+    void fields(miral::TraceRecord const& record)
+    {
+        if (record.extra & miral::trace_type) out << " type=" << MirWindowType(record.detail);
+        if (record.extra & miral::trace_state) out << " state=" << MirWindowState(record.object);
+        if (record.extra & miral::trace_top_left) out << " top_left=" << rect(record).top_left;
+        if (record.extra & miral::trace_size) out << " size=" << rect(record).size;
+    }
+};
+}
+
+miral::TraceRecordBuffer::TraceRecordBuffer(std::size_t capacity) :
+    ring(capacity)
+{
+    if (capacity == 0)
+        BOOST_THROW_EXCEPTION(std::invalid_argument("Trace buffer capacity must be positive"));
+}
+
+void miral::TraceRecordBuffer::push(TraceRecord const& record)
+{
+    ring[pushed++ % ring.size()] = record;
+}
+
+auto miral::TraceRecordBuffer::records() const -> std::vector<TraceRecord>
+{
+    if (pushed <= ring.size())
+        return {ring.begin(), ring.begin() + pushed};
+
+    auto const oldest = ring.begin() + pushed % ring.size();
+
+    std::vector<TraceRecord> result{oldest, ring.end()};
+    result.insert(result.end(), ring.begin(), oldest);
+    return result;
+}
+
+void miral::save_trace(std::string const& filename, std::vector<TraceRecord> const& records)
+{
+    std::ofstream out{filename, std::ios::binary};
+
+    TraceFileHeader header;
+    std::memcpy(header.magic, trace_magic, sizeof header.magic);
+    header.record_size = sizeof(TraceRecord);
+    header.record_count = records.size();
+
+    out.write(reinterpret_cast<char const*>(&header), sizeof header);
+    out.write(reinterpret_cast<char const*>(records.data()), records.size() * sizeof(TraceRecord));
+
+    if (!out)
+        BOOST_THROW_EXCEPTION(std::runtime_error("Failed to write window management trace: " + filename));
+}
+
+auto miral::load_trace(std::string const& filename) -> std::vector<TraceRecord>
+{
+    std::ifstream in{filename, std::ios::binary};
+
+    TraceFileHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof header) ||
+        std::memcmp(header.magic, trace_magic, sizeof header.magic) != 0 ||
+        header.record_size != sizeof(TraceRecord))
+        BOOST_THROW_EXCEPTION(std::runtime_error("Not a window management trace: " + filename));
+
+    std::vector<TraceRecord> result(header.record_count);
+    if (!in.read(reinterpret_cast<char*>(result.data()), result.size() * sizeof(TraceRecord)))
+        BOOST_THROW_EXCEPTION(std::runtime_error("Truncated window management trace: " + filename));
+
+    return result;
+}
+
+void miral::dump_trace(std::ostream& out, std::vector<TraceRecord> const& records)
+{
+    TraceFormatter formatter{out};
+
+    for (auto const& record : records)
+        formatter.format(record);
+}
+
+miral::WindowManagementRecorder::WindowManagementRecorder(
+    WindowManagerTools const& tools,
+    WindowManagementPolicyBuilder const& builder,
+    std::shared_ptr<TraceRecordBuffer> const& buffer,
+    std::string const& filename) :
+    policy(builder(tools)),
+    buffer{buffer},
+    filename{filename}
+{
+}
+
+miral::WindowManagementRecorder::~WindowManagementRecorder()
+{
+    if (filename.empty())
+        return;
+
+    try
+    {
+        save_trace(filename, buffer->records());
+    }
+    catch (std::exception const& error)
+    {
+        mir::log_warning("%s", error.what());
+    }
+}
+
+void miral::WindowManagementRecorder::record(TraceCall call, std::uint64_t subject, std::uint64_t object)
+{
+    buffer->push(make_record(now(), call, subject, object));
+}
+
+void miral::WindowManagementRecorder::record(TraceCall call, WindowInfo const& window_info, Rectangle const& rect)
+{
+    auto result = make_record(now(), call, id_of(window_info.window()), 0);
+    set_rect(result, rect);
+    buffer->push(result);
+}
+
+void miral::WindowManagementRecorder::record(TraceCall call, Output const& output)
+{
+    auto result = make_record(now(), call, 0, 0);
+    set_rect(result, output.extents());
+    buffer->push(result);
+}
+
+void miral::WindowManagementRecorder::record(
+    TraceCall call, std::shared_ptr<Workspace> const& workspace, std::vector<Window> const& windows)
+{
+    auto const time = now();
+    auto const workspace_id = reinterpret_cast<std::uintptr_t>(workspace.get());
+
+    for (auto const& window : windows)
+        buffer->push(make_record(time, call, id_of(window), workspace_id));
+}
+
+auto miral::WindowManagementRecorder::place_new_window(
+    ApplicationInfo const& app_info,
+    WindowSpecification const& requested_specification) -> WindowSpecification
+{
+    auto const time = now();
+
+    if (requested_specification.name().is_set())
+    {
+        auto name = make_record(time, TraceCall::window_name, 0, 0);
+        set_name(name, requested_specification.name().value());
+        buffer->push(name);
+    }
+
+    if (requested_specification.parent().is_set())
+    {
+        if (auto const parent = requested_specification.parent().value().lock())
+            buffer->push(make_record(time, TraceCall::window_parent, 0, reinterpret_cast<std::uintptr_t>(parent.get())));
+    }
+
+    auto request = make_record(time, TraceCall::place_new_window, id_of(app_info.application()), 0);
+
+    if (requested_specification.type().is_set())
+    {
+        request.extra |= trace_type;
+        request.detail = requested_specification.type().value();
+    }
+
+    if (requested_specification.state().is_set())
+    {
+        request.extra |= trace_state;
+        request.object = requested_specification.state().value();
+    }
+
+    if (requested_specification.top_left().is_set())
+    {
+        request.extra |= trace_top_left;
+        request.rect.x = requested_specification.top_left().value().x.as_int();
+        request.rect.y = requested_specification.top_left().value().y.as_int();
+    }
+
+    if (requested_specification.size().is_set())
+    {
+        request.extra |= trace_size;
+        request.rect.width = requested_specification.size().value().width.as_int();
+        request.rect.height = requested_specification.size().value().height.as_int();
+    }
+
+    buffer->push(request);
+
+    return policy->place_new_window(app_info, requested_specification);
+}
+
+void miral::WindowManagementRecorder::handle_window_ready(WindowInfo& window_info)
+{
+    record(TraceCall::handle_window_ready, id_of(window_info.window()));
+    policy->handle_window_ready(window_info);
+}
+
+void miral::WindowManagementRecorder::handle_modify_window(
+    WindowInfo& window_info, WindowSpecification const& modifications)
+{
+    auto modify = make_record(now(), TraceCall::handle_modify_window, id_of(window_info.window()), 0);
+
+    if (modifications.type().is_set())
+    {
+        modify.extra |= trace_type;
+        modify.detail = modifications.type().value();
+    }
+
+    if (modifications.state().is_set())
+    {
+        modify.extra |= trace_state;
+        modify.object = modifications.state().value();
+    }
+
+    if (modifications.top_left().is_set())
+    {
+        modify.extra |= trace_top_left;
+        modify.rect.x = modifications.top_left().value().x.as_int();
+        modify.rect.y = modifications.top_left().value().y.as_int();
+    }
+
+    if (modifications.size().is_set())
+    {
+        modify.extra |= trace_size;
+        modify.rect.width = modifications.size().value().width.as_int();
+        modify.rect.height = modifications.size().value().height.as_int();
+    }
+
+    buffer->push(modify);
+    policy->handle_modify_window(window_info, modifications);
+}
+
+void miral::WindowManagementRecorder::handle_raise_window(WindowInfo& window_info)
+{
+    record(TraceCall::handle_raise_window, id_of(window_info.window()));
+    policy->handle_raise_window(window_info);
+}
+
+bool miral::WindowManagementRecorder::handle_keyboard_event(MirKeyboardEvent const* event)
+{
+    auto key = make_record(
+        input_time(mir_keyboard_event_input_event(event)),
+        TraceCall::handle_keyboard_event,
+        mir_keyboard_event_key_code(event),
+        mir_keyboard_event_scan_code(event));
+
+    key.detail = mir_keyboard_event_action(event);
+    key.extra = mir_keyboard_event_modifiers(event);
+    buffer->push(key);
+
+    return policy->handle_keyboard_event(event);
+}
+
+bool miral::WindowManagementRecorder::handle_touch_event(MirTouchEvent const* event)
+{
+    auto const time = input_time(mir_touch_event_input_event(event));
+    auto const modifiers = mir_touch_event_modifiers(event);
+    auto const count = mir_touch_event_point_count(event);
+
+    for (unsigned int index = 0; index != count; ++index)
+    {
+        auto touch = make_record(
+            time,
+            TraceCall::handle_touch_event,
+            mir_touch_event_id(event, index),
+            std::uint64_t(mir_touch_event_tooltype(event, index)) << 32 | count << 16 | index);
+
+        touch.detail = mir_touch_event_action(event, index);
+        touch.extra = modifiers;
+        touch.axis[0] = mir_touch_event_axis_value(event, index, mir_touch_axis_x);
+        touch.axis[1] = mir_touch_event_axis_value(event, index, mir_touch_axis_y);
+        touch.axis[2] = mir_touch_event_axis_value(event, index, mir_touch_axis_pressure);
+        touch.axis[3] = mir_touch_event_axis_value(event, index, mir_touch_axis_touch_major);
+        touch.axis[4] = mir_touch_event_axis_value(event, index, mir_touch_axis_touch_minor);
+        touch.axis[5] = mir_touch_event_axis_value(event, index, mir_touch_axis_size);
+        buffer->push(touch);
+    }
+
+    return policy->handle_touch_event(event);
+}
+
+bool miral::WindowManagementRecorder::handle_pointer_event(MirPointerEvent const* event)
+{
+    auto pointer = make_record(
+        input_time(mir_pointer_event_input_event(event)),
+        TraceCall::handle_pointer_event,
+        0,
+        mir_pointer_event_modifiers(event));
+
+    pointer.detail = mir_pointer_event_action(event);
+    pointer.extra = mir_pointer_event_buttons(event);
+    pointer.axis[0] = mir_pointer_event_axis_value(event, mir_pointer_axis_x);
+    pointer.axis[1] = mir_pointer_event_axis_value(event, mir_pointer_axis_y);
+    pointer.axis[2] = mir_pointer_event_axis_value(event, mir_pointer_axis_hscroll);
+    pointer.axis[3] = mir_pointer_event_axis_value(event, mir_pointer_axis_vscroll);
+    pointer.axis[4] = mir_pointer_event_axis_value(event, mir_pointer_axis_relative_x);
+    pointer.axis[5] = mir_pointer_event_axis_value(event, mir_pointer_axis_relative_y);
+    buffer->push(pointer);
+
+    return policy->handle_pointer_event(event);
+}
+
+void miral::WindowManagementRecorder::handle_request_drag_and_drop(WindowInfo& window_info)
+{
+    record(TraceCall::handle_request_drag_and_drop, id_of(window_info.window()));
+    policy->handle_request_drag_and_drop(window_info);
+}
+
+void miral::WindowManagementRecorder::handle_request_move(WindowInfo& window_info, MirInputEvent const* input_event)
+{
+    record(TraceCall::handle_request_move, id_of(window_info.window()), input_time(input_event));
+    policy->handle_request_move(window_info, input_event);
+}
+
+void miral::WindowManagementRecorder::handle_request_resize(
+    WindowInfo& window_info, MirInputEvent const* input_event, MirResizeEdge edge)
+{
+    auto resize = make_record(
+        now(), TraceCall::handle_request_resize, id_of(window_info.window()), input_time(input_event));
+    resize.detail = edge;
+    buffer->push(resize);
+
+    policy->handle_request_resize(window_info, input_event, edge);
+}
+
+auto miral::WindowManagementRecorder::confirm_inherited_move(WindowInfo const& window_info, Displacement movement)
+-> Rectangle
+{
+    auto const result = policy->confirm_inherited_move(window_info, movement);
+    record(TraceCall::confirm_inherited_move, window_info, result);
+    return result;
+}
+
+auto miral::WindowManagementRecorder::confirm_placement_on_display(
+    WindowInfo const& window_info,
+    MirWindowState new_state,
+    Rectangle const& new_placement) -> Rectangle
+{
+    auto const result = policy->confirm_placement_on_display(window_info, new_state, new_placement);
+    record(TraceCall::confirm_placement_on_display, window_info, result);
+    return result;
+}
+
+void miral::WindowManagementRecorder::advise_begin()
+{
+    policy->advise_begin();
+}
+
+void miral::WindowManagementRecorder::advise_end()
+{
+    policy->advise_end();
+}
+
+void miral::WindowManagementRecorder::advise_new_app(ApplicationInfo& application)
+{
+    auto app = make_record(now(), TraceCall::advise_new_app, id_of(application.application()), 0);
+    set_name(app, application.name());
+    buffer->push(app);
+
+    policy->advise_new_app(application);
+}
+
+void miral::WindowManagementRecorder::advise_delete_app(ApplicationInfo const& application)
+{
+    record(TraceCall::advise_delete_app, id_of(application.application()));
+    policy->advise_delete_app(application);
+}
+
+void miral::WindowManagementRecorder::advise_new_window(WindowInfo const& window_info)
+{
+    auto const time = now();
+    auto const window = id_of(window_info.window());
+
+    auto name = make_record(time, TraceCall::window_name, window, 0);
+    set_name(name, window_info.name());
+    buffer->push(name);
+
+    auto created = make_record(time, TraceCall::advise_new_window, window, id_of(window_info.window().application()));
+    created.detail = window_info.type();
+    created.extra = window_info.state();
+    set_rect(created, {window_info.window().top_left(), window_info.window().size()});
+    buffer->push(created);
+
+    policy->advise_new_window(window_info);
+}
+
+void miral::WindowManagementRecorder::advise_focus_lost(WindowInfo const& window_info)
+{
+    record(TraceCall::advise_focus_lost, id_of(window_info.window()));
+    policy->advise_focus_lost(window_info);
+}
+
+void miral::WindowManagementRecorder::advise_focus_gained(WindowInfo const& window_info)
+{
+    record(TraceCall::advise_focus_gained, id_of(window_info.window()));
+    policy->advise_focus_gained(window_info);
+}
+
+void miral::WindowManagementRecorder::advise_state_change(WindowInfo const& window_info, MirWindowState state)
+{
+    auto change = make_record(now(), TraceCall::advise_state_change, id_of(window_info.window()), 0);
+    change.detail = state;
+    buffer->push(change);
+
+    policy->advise_state_change(window_info, state);
+}
+
+void miral::WindowManagementRecorder::advise_move_to(WindowInfo const& window_info, Point top_left)
+{
+    record(TraceCall::advise_move_to, window_info, {top_left, {}});
+    policy->advise_move_to(window_info, top_left);
+}
+
+void miral::WindowManagementRecorder::advise_resize(WindowInfo const& window_info, Size const& new_size)
+{
+    record(TraceCall::advise_resize, window_info, {{}, new_size});
+    policy->advise_resize(window_info, new_size);
+}
+
+void miral::WindowManagementRecorder::advise_delete_window(WindowInfo const& window_info)
+{
+    record(TraceCall::advise_delete_window, id_of(window_info.window()), id_of(window_info.window().application()));
+    policy->advise_delete_window(window_info);
+}
+
+void miral::WindowManagementRecorder::advise_raise(std::vector<Window> const& windows)
+{
+    auto const time = now();
+
+    for (auto const& window : windows)
+        buffer->push(make_record(time, TraceCall::advise_raise, id_of(window), 0));
+
+    policy->advise_raise(windows);
+}
+
+void miral::WindowManagementRecorder::advise_adding_to_workspace(
+    std::shared_ptr<Workspace> const& workspace, std::vector<Window> const& windows)
+{
+    record(TraceCall::advise_adding_to_workspace, workspace, windows);
+    policy->advise_adding_to_workspace(workspace, windows);
+}
+
+void miral::WindowManagementRecorder::advise_removing_from_workspace(
+    std::shared_ptr<Workspace> const& workspace, std::vector<Window> const& windows)
+{
+    record(TraceCall::advise_removing_from_workspace, workspace, windows);
+    policy->advise_removing_from_workspace(workspace, windows);
+}
+
+void miral::WindowManagementRecorder::advise_output_create(Output const& output)
+{
+    record(TraceCall::advise_output_create, output);
+    policy->advise_output_create(output);
+}
+
+void miral::WindowManagementRecorder::advise_output_update(Output const& updated, Output const& original)
+{
+    auto const extents = original.extents();
+
+    // The original extents are packed into subject and object
+    auto update = make_record(
+        now(),
+        TraceCall::advise_output_update,
+        std::uint64_t(std::uint32_t(extents.top_left.x.as_int())) << 32 | std::uint32_t(extents.top_left.y.as_int()),
+        std::uint64_t(std::uint32_t(extents.size.width.as_int())) << 32 | std::uint32_t(extents.size.height.as_int()));
+    set_rect(update, updated.extents());
+    buffer->push(update);
+
+    policy->advise_output_update(updated, original);
+}
+
+void miral::WindowManagementRecorder::advise_output_delete(Output const& output)
+{
+    record(TraceCall::advise_output_delete, output);
+    policy->advise_output_delete(output);
+}
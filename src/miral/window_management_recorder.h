@@ -0,0 +1,180 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRAL_WINDOW_MANAGEMENT_RECORDER_H
+#define MIRAL_WINDOW_MANAGEMENT_RECORDER_H
+
+#include "miral/window_management_options.h"
+#include "miral/window_management_policy.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace miral
+{
+/// The policy calls captured by a WindowManagementRecorder
+enum class TraceCall : std::uint16_t
+{
+    window_name,                    ///< names the window of the following place_new_window or advise_new_window
+    window_parent,                  ///< parents the window of the following place_new_window
+    place_new_window,
+    handle_window_ready,
+    handle_modify_window,
+    handle_raise_window,
+    handle_keyboard_event,
+    handle_touch_event,             ///< one record per touch point
+    handle_pointer_event,
+    handle_request_drag_and_drop,
+    handle_request_move,
+    handle_request_resize,
+    confirm_inherited_move,
+    confirm_placement_on_display,
+    advise_new_app,
+    advise_delete_app,
+    advise_new_window,
+    advise_focus_lost,
+    advise_focus_gained,
+    advise_state_change,
+    advise_move_to,
+    advise_resize,
+    advise_delete_window,
+    advise_raise,                   ///< one record per window
+    advise_output_create,
+    advise_output_update,
+    advise_output_delete,
+    advise_adding_to_workspace,     ///< one record per window
+    advise_removing_from_workspace, ///< one record per window
+};
+
+/// Bits of TraceRecord::extra saying which fields of a requested or modified window are set
+enum TraceFields : std::uint32_t
+{
+    trace_top_left = 1 << 0,
+    trace_size     = 1 << 1,
+    trace_state    = 1 << 2,
+    trace_type     = 1 << 3,
+};
+
+/// One policy call, recorded without formatting anything.
+/// Windows, applications and workspaces are identified by the address of the underlying object.
+struct TraceRecord
+{
+    std::int64_t time;      ///< CLOCK_MONOTONIC (ns): the event time for input
+    TraceCall call;
+    std::uint16_t detail;   ///< state, type, action or resize edge
+    std::uint32_t extra;    ///< TraceFields, modifiers or pointer buttons
+    std::uint64_t subject;  ///< the window or application concerned (or the key code or touch id)
+    std::uint64_t object;   ///< the window's application, a parent, a workspace, a state or an input timestamp
+    union
+    {
+        struct { std::int32_t x, y, width, height; } rect;
+        float axis[6];
+        char name[24];
+    };
+};
+
+/// A fixed size ring of the most recent TraceRecords.
+/// Not synchronized: policy calls are serialized by the window manager's lock.
+class TraceRecordBuffer
+{
+public:
+    static std::size_t const default_capacity = 65536;
+
+    explicit TraceRecordBuffer(std::size_t capacity = default_capacity);
+
+    void push(TraceRecord const& record);
+
+    /// The retained records, oldest first
+    auto records() const -> std::vector<TraceRecord>;
+
+private:
+    std::vector<TraceRecord> ring;
+    std::uint64_t pushed = 0;
+};
+
+void save_trace(std::string const& filename, std::vector<TraceRecord> const& records);
+auto load_trace(std::string const& filename) -> std::vector<TraceRecord>;
+
+/// Formats records in the style of the WindowManagementTrace log
+void dump_trace(std::ostream& out, std::vector<TraceRecord> const& records);
+
+/// A cheap alternative to WindowManagementTrace: records every policy call into a TraceRecordBuffer
+/// (and, if filename is not empty, saves the buffer there when the policy is destroyed).
+class WindowManagementRecorder : public WindowManagementPolicy
+{
+public:
+    WindowManagementRecorder(
+        WindowManagerTools const& tools,
+        WindowManagementPolicyBuilder const& builder,
+        std::shared_ptr<TraceRecordBuffer> const& buffer,
+        std::string const& filename);
+
+    ~WindowManagementRecorder();
+
+    auto place_new_window(
+        ApplicationInfo const& app_info,
+        WindowSpecification const& requested_specification) -> WindowSpecification override;
+    void handle_window_ready(WindowInfo& window_info) override;
+    void handle_modify_window(WindowInfo& window_info, WindowSpecification const& modifications) override;
+    void handle_raise_window(WindowInfo& window_info) override;
+    bool handle_keyboard_event(MirKeyboardEvent const* event) override;
+    bool handle_touch_event(MirTouchEvent const* event) override;
+    bool handle_pointer_event(MirPointerEvent const* event) override;
+    void handle_request_drag_and_drop(WindowInfo& window_info) override;
+    void handle_request_move(WindowInfo& window_info, MirInputEvent const* input_event) override;
+    void handle_request_resize(WindowInfo& window_info, MirInputEvent const* input_event, MirResizeEdge edge) override;
+    auto confirm_inherited_move(WindowInfo const& window_info, Displacement movement) -> Rectangle override;
+    auto confirm_placement_on_display(
+        WindowInfo const& window_info,
+        MirWindowState new_state,
+        Rectangle const& new_placement) -> Rectangle override;
+
+    void advise_begin() override;
+    void advise_end() override;
+    void advise_new_app(ApplicationInfo& application) override;
+    void advise_delete_app(ApplicationInfo const& application) override;
+    void advise_new_window(WindowInfo const& window_info) override;
+    void advise_focus_lost(WindowInfo const& window_info) override;
+    void advise_focus_gained(WindowInfo const& window_info) override;
+    void advise_state_change(WindowInfo const& window_info, MirWindowState state) override;
+    void advise_move_to(WindowInfo const& window_info, Point top_left) override;
+    void advise_resize(WindowInfo const& window_info, Size const& new_size) override;
+    void advise_delete_window(WindowInfo const& window_info) override;
+    void advise_raise(std::vector<Window> const& windows) override;
+    void advise_adding_to_workspace(
+        std::shared_ptr<Workspace> const& workspace, std::vector<Window> const& windows) override;
+    void advise_removing_from_workspace(
+        std::shared_ptr<Workspace> const& workspace, std::vector<Window> const& windows) override;
+    void advise_output_create(Output const& output) override;
+    void advise_output_update(Output const& updated, Output const& original) override;
+    void advise_output_delete(Output const& output) override;
+
+private:
+    std::unique_ptr<WindowManagementPolicy> const policy;
+    std::shared_ptr<TraceRecordBuffer> const buffer;
+    std::string const filename;
+
+    void record(TraceCall call, std::uint64_t subject, std::uint64_t object = 0);
+    void record(TraceCall call, WindowInfo const& window_info, Rectangle const& rect);
+    void record(TraceCall call, Output const& output);
+    void record(TraceCall call, std::shared_ptr<Workspace> const& workspace, std::vector<Window> const& windows);
+};
+}
+
+#endif //MIRAL_WINDOW_MANAGEMENT_RECORDER_H
@@ -0,0 +1,330 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "window_management_replay.h"
+#include "basic_window_manager.h"
+
+#include <miral/output.h>
+
+#include <mir/graphics/display_configuration.h>
+#include <mir/scene/session.h>
+#include <mir/shell/surface_specification.h>
+
+namespace mev = mir::events;
+namespace mg = mir::graphics;
+namespace ms = mir::scene;
+namespace msh = mir::shell;
+
+namespace
+{
+auto output_for(mir::geometry::Rectangle const& extents) -> miral::Output
+{
+    mg::DisplayConfigurationOutput output;
+    output.id = mg::DisplayConfigurationOutputId{0};
+    output.card_id = mg::DisplayConfigurationCardId{0};
+    output.type = mg::DisplayConfigurationOutputType::unknown;
+    output.preferred_mode_index = 0;
+    output.current_mode_index = 0;
+    output.modes.push_back({extents.size, 60.0});
+    output.connected = true;
+    output.used = true;
+    output.top_left = extents.top_left;
+    output.power_mode = mir_power_mode_on;
+    output.orientation = mir_orientation_normal;
+    output.scale = 1.0f;
+    output.custom_logical_size = extents.size;
+    return miral::Output{output};
+}
+
+auto rect_of(miral::TraceRecord const& record) -> mir::geometry::Rectangle
+{
+    return {{record.rect.x, record.rect.y}, {record.rect.width, record.rect.height}};
+}
+
+auto create_surface(std::shared_ptr<ms::Session> const& session, ms::SurfaceCreationParameters const& params)
+-> mir::frontend::SurfaceId
+{
+    return session->create_surface(params, {});
+}
+}
+
+miral::WindowManagementReplay::WindowManagementReplay(
+    BasicWindowManager& window_manager,
+    SessionBuilder const& build_session,
+    FramePoster const& post_frame) :
+    window_manager(window_manager),
+    build_session{build_session},
+    post_frame{post_frame}
+{
+}
+
+miral::WindowManagementReplay::~WindowManagementReplay() = default;
+
+void miral::WindowManagementReplay::replay(TraceRecord const& record)
+{
+    switch (record.call)
+    {
+    case TraceCall::window_name:
+        // Names of windows already created just label them for dump_trace()
+        if (!record.subject)
+            requested.name = record.name;
+        return;
+
+    case TraceCall::window_parent:
+    {
+        auto const parent = windows.find(record.object);
+        if (parent != windows.end())
+            requested.parent = parent->second.surface;
+        return;
+    }
+
+    case TraceCall::place_new_window:
+        replay_new_window(record);
+        break;
+
+    case TraceCall::advise_new_window:
+        if (created.surface)
+            windows[record.subject] = std::move(created);
+        created = {};
+        break;
+
+    case TraceCall::advise_new_app:
+    {
+        auto const session = build_session(record.name);
+        sessions[record.subject] = session;
+        window_manager.add_session(session);
+        break;
+    }
+
+    case TraceCall::advise_delete_app:
+    {
+        auto const session = sessions.find(record.subject);
+        if (session != sessions.end())
+        {
+            window_manager.remove_session(session->second);
+            sessions.erase(session);
+        }
+        break;
+    }
+
+    case TraceCall::advise_delete_window:
+    case TraceCall::handle_window_ready:
+    case TraceCall::handle_modify_window:
+    case TraceCall::handle_raise_window:
+    case TraceCall::handle_request_drag_and_drop:
+    case TraceCall::handle_request_move:
+    case TraceCall::handle_request_resize:
+        replay_window_call(record);
+        break;
+
+    case TraceCall::handle_keyboard_event:
+    case TraceCall::handle_touch_event:
+    case TraceCall::handle_pointer_event:
+        replay_input(record);
+        break;
+
+    case TraceCall::advise_output_create:
+    case TraceCall::advise_output_update:
+    case TraceCall::advise_output_delete:
+        replay_output(record);
+        break;
+
+    default:
+        // The remaining calls record decisions the policy will make again
+        break;
+    }
+
+    requested = {};
+}
+
+void miral::WindowManagementReplay::replay_new_window(TraceRecord const& record)
+{
+    auto const session = sessions.find(record.subject);
+    if (session == sessions.end())
+        return;
+
+    auto params = requested;
+    params.type = (record.extra & trace_type) ? MirWindowType(record.detail) : mir_window_type_normal;
+
+    if (record.extra & trace_state)
+        params.state = MirWindowState(record.object);
+
+    if (record.extra & trace_top_left)
+        params.top_left = rect_of(record).top_left;
+
+    if (record.extra & trace_size)
+        params.size = rect_of(record).size;
+
+    auto const id = window_manager.add_surface(session->second, params, &create_surface);
+    created = {session->second, session->second->surface(id)};
+}
+
+void miral::WindowManagementReplay::replay_window_call(TraceRecord const& record)
+{
+    auto const window = windows.find(record.subject);
+    if (window == windows.end())
+        return;
+
+    auto const& session = window->second.session;
+    auto const& surface = window->second.surface;
+
+    switch (record.call)
+    {
+    case TraceCall::advise_delete_window:
+    {
+        // Keep the window alive until the window manager has finished with it
+        auto const doomed = window->second;
+        windows.erase(window);
+        window_manager.remove_surface(doomed.session, doomed.surface);
+        break;
+    }
+
+    case TraceCall::handle_window_ready:
+        post_frame(surface);
+        break;
+
+    case TraceCall::handle_modify_window:
+    {
+        // Clients cannot ask to be moved, so top_left (if recorded) was the policy's doing
+        msh::SurfaceSpecification modifications;
+
+        if (record.extra & trace_type)
+            modifications.type = MirWindowType(record.detail);
+
+        if (record.extra & trace_state)
+            modifications.state = MirWindowState(record.object);
+
+        if (record.extra & trace_size)
+        {
+            modifications.width = rect_of(record).size.width;
+            modifications.height = rect_of(record).size.height;
+        }
+
+        window_manager.modify_surface(session, surface, modifications);
+        break;
+    }
+
+    case TraceCall::handle_raise_window:
+        window_manager.handle_raise_surface(session, surface, record.time);
+        break;
+
+    case TraceCall::handle_request_drag_and_drop:
+        window_manager.handle_request_drag_and_drop(session, surface, record.time);
+        break;
+
+    case TraceCall::handle_request_move:
+        window_manager.handle_request_move(session, surface, record.object);
+        break;
+
+    case TraceCall::handle_request_resize:
+        window_manager.handle_request_resize(session, surface, record.object, MirResizeEdge(record.detail));
+        break;
+
+    default:
+        break;
+    }
+}
+
+void miral::WindowManagementReplay::replay_input(TraceRecord const& record)
+{
+    MirInputDeviceId const device{0};
+    std::chrono::nanoseconds const timestamp{record.time};
+    std::vector<uint8_t> const cookie;
+
+    switch (record.call)
+    {
+    case TraceCall::handle_keyboard_event:
+    {
+        auto const event = mev::make_event(
+            device, timestamp, cookie, MirKeyboardAction(record.detail),
+            xkb_keysym_t(record.subject), int(record.object), MirInputEventModifiers(record.extra));
+
+        window_manager.handle_keyboard_event(
+            mir_input_event_get_keyboard_event(mir_event_get_input_event(event.get())));
+        break;
+    }
+
+    case TraceCall::handle_pointer_event:
+    {
+        auto const event = mev::make_event(
+            device, timestamp, cookie, MirInputEventModifiers(record.object), MirPointerAction(record.detail),
+            MirPointerButtons(record.extra), record.axis[0], record.axis[1],
+            record.axis[2], record.axis[3], record.axis[4], record.axis[5]);
+
+        window_manager.handle_pointer_event(
+            mir_input_event_get_pointer_event(mir_event_get_input_event(event.get())));
+        break;
+    }
+
+    case TraceCall::handle_touch_event:
+    {
+        // The points of one event are recorded consecutively: index in the low bits, count above it
+        auto const index = record.object & 0xffff;
+        auto const count = (record.object >> 16) & 0xffff;
+
+        if (index == 0)
+            touch_event = mev::make_event(device, timestamp, cookie, MirInputEventModifiers(record.extra));
+
+        if (!touch_event)
+            break;
+
+        mev::add_touch(
+            *touch_event, MirTouchId(record.subject), MirTouchAction(record.detail),
+            MirTouchTooltype(record.object >> 32), record.axis[0], record.axis[1],
+            record.axis[2], record.axis[3], record.axis[4], record.axis[5]);
+
+        if (index + 1 == count)
+        {
+            auto const event = std::move(touch_event);
+            window_manager.handle_touch_event(
+                mir_input_event_get_touch_event(mir_event_get_input_event(event.get())));
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+void miral::WindowManagementReplay::replay_output(TraceRecord const& record)
+{
+    ActiveOutputsListener& outputs = window_manager;
+
+    switch (record.call)
+    {
+    case TraceCall::advise_output_create:
+        outputs.advise_output_create(output_for(rect_of(record)));
+        break;
+
+    case TraceCall::advise_output_update:
+    {
+        mir::geometry::Rectangle const original{
+            {std::int32_t(record.subject >> 32), std::int32_t(record.subject)},
+            {std::int32_t(record.object >> 32), std::int32_t(record.object)}};
+
+        outputs.advise_output_update(output_for(rect_of(record)), output_for(original));
+        break;
+    }
+
+    case TraceCall::advise_output_delete:
+        outputs.advise_output_delete(output_for(rect_of(record)));
+        break;
+
+    default:
+        break;
+    }
+}
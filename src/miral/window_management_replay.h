@@ -0,0 +1,83 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRAL_WINDOW_MANAGEMENT_REPLAY_H
+#define MIRAL_WINDOW_MANAGEMENT_REPLAY_H
+
+#include "window_management_recorder.h"
+
+#include <mir/events/event_builders.h>
+#include <mir/scene/surface_creation_parameters.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace mir { namespace scene { class Session; class Surface; }}
+
+namespace miral
+{
+class BasicWindowManager;
+
+/// Feeds a recorded trace back into a BasicWindowManager (and hence its policy).
+/// Only the calls that originate outside the policy (clients, input and outputs) are replayed:
+/// the policy's own decisions are left for it to make again, so recording the replay reproduces them.
+class WindowManagementReplay
+{
+public:
+    /// Connects a stand-in for a recorded client
+    using SessionBuilder = std::function<std::shared_ptr<mir::scene::Session>(std::string const& name)>;
+
+    /// Makes the surface behave as if its first frame had been posted
+    using FramePoster = std::function<void(std::shared_ptr<mir::scene::Surface> const& surface)>;
+
+    WindowManagementReplay(
+        BasicWindowManager& window_manager,
+        SessionBuilder const& build_session,
+        FramePoster const& post_frame);
+
+    ~WindowManagementReplay();
+
+    /// Calls referring to applications or windows created before the trace begins are skipped
+    void replay(TraceRecord const& record);
+
+private:
+    struct ClientWindow
+    {
+        std::shared_ptr<mir::scene::Session> session;
+        std::shared_ptr<mir::scene::Surface> surface;
+    };
+
+    BasicWindowManager& window_manager;
+    SessionBuilder const build_session;
+    FramePoster const post_frame;
+
+    std::unordered_map<std::uint64_t, std::shared_ptr<mir::scene::Session>> sessions;
+    std::unordered_map<std::uint64_t, ClientWindow> windows;
+
+    mir::scene::SurfaceCreationParameters requested;
+    ClientWindow created;
+    mir::EventUPtr touch_event{nullptr, [](MirEvent*){}};
+
+    void replay_new_window(TraceRecord const& record);
+    void replay_window_call(TraceRecord const& record);
+    void replay_input(TraceRecord const& record);
+    void replay_output(TraceRecord const& record);
+};
+}
+
+#endif //MIRAL_WINDOW_MANAGEMENT_REPLAY_H
@@ -599,6 +599,13 @@ try {
 }
 MIRAL_TRACE_EXCEPTION
 
+void miral::WindowManagementTrace::invoke_under_shared_lock(std::function<void()> const& callback)
+try {
+    mir::log_info("%s", __func__);
+    wrapped.invoke_under_shared_lock(callback);
+}
+MIRAL_TRACE_EXCEPTION
+
 auto miral::WindowManagementTrace::create_workspace() -> std::shared_ptr<Workspace>
 try {
     mir::log_info("%s", __func__);
@@ -76,6 +76,7 @@ private:
     virtual void modify_window(WindowInfo& window_info, WindowSpecification const& modifications) override;
 
     virtual void invoke_under_lock(std::function<void()> const& callback) override;
+    virtual void invoke_under_shared_lock(std::function<void()> const& callback) override;
 
     virtual auto place_new_window(
         ApplicationInfo const& app_info,
@@ -96,6 +96,9 @@ public:
  *  already holds the lock).
  *  @{ */
     virtual void invoke_under_lock(std::function<void()> const& callback) = 0;
+
+    // As invoke_under_lock(), but callbacks may run concurrently and must only call the query functions
+    virtual void invoke_under_shared_lock(std::function<void()> const& callback) = 0;
 /** @} */
 
     virtual ~WindowManagerToolsImplementation() = default;
@@ -326,6 +326,58 @@ std::vector<MirPixelFormat> mgm::BufferAllocator::supported_pixel_formats()
 
 namespace
 {
+class WaylandBufferImage
+{
+public:
+    WaylandBufferImage(
+        EGLDisplay dpy,
+        wl_resource* buffer,
+        std::shared_ptr<mg::EGLExtensions> const& extensions)
+        : dpy{dpy},
+          extensions{extensions},
+          egl_image{create_image(dpy, buffer, *extensions)}
+    {
+    }
+
+    ~WaylandBufferImage()
+    {
+        extensions->eglDestroyImageKHR(dpy, egl_image);
+    }
+
+    EGLImageKHR image() const
+    {
+        return egl_image;
+    }
+
+private:
+    static EGLImageKHR create_image(EGLDisplay dpy, wl_resource* buffer, mg::EGLExtensions const& extensions)
+    {
+        eglBindAPI(MIR_SERVER_EGL_OPENGL_API);
+
+        const EGLint image_attrs[] =
+            {
+                EGL_IMAGE_PRESERVED_KHR, EGL_TRUE,
+                EGL_NONE
+            };
+
+        auto const image = extensions.eglCreateImageKHR(
+            dpy,
+            EGL_NO_CONTEXT,
+            EGL_WAYLAND_BUFFER_WL,
+            buffer,
+            image_attrs);
+
+        if (image == EGL_NO_IMAGE_KHR)
+            BOOST_THROW_EXCEPTION(mg::egl_error("Failed to create EGLImage"));
+
+        return image;
+    }
+
+    EGLDisplay const dpy;
+    std::shared_ptr<mg::EGLExtensions> const extensions;
+    EGLImageKHR const egl_image;
+};
+
 class WaylandBuffer :
     public mir::graphics::BufferBasic,
     public mir::graphics::NativeBufferBase,
@@ -381,16 +433,13 @@ public:
             wl_resource_add_destroy_listener(buffer, &shim->destruction_listener);
         }
 
-        mir_buffer->buffer_mutex = shim->mutex;
+        mir_buffer->buffer_state = shim->state;
         return mir_buffer;
     }
 
     ~WaylandBuffer()
     {
-        if (egl_image != EGL_NO_IMAGE_KHR)
-            extensions->eglDestroyImageKHR(dpy, egl_image);
-
-        std::lock_guard<std::mutex> lock{*buffer_mutex};
+        std::lock_guard<std::mutex> lock{buffer_state->mutex};
         if (buffer)
         {
             on_release();
@@ -399,35 +448,23 @@ public:
 
     void gl_bind_to_texture() override
     {
-        std::unique_lock<std::mutex> lock{*buffer_mutex};
+        std::unique_lock<std::mutex> lock{buffer_state->mutex};
         if (buffer == nullptr)
         {
             mir::log_warning("WaylandBuffer::gl_bind_to_texture() called on a destroyed wl_buffer", this);
             return;
         }
-        if (egl_image == EGL_NO_IMAGE_KHR)
+        if (!egl_image)
         {
-            eglBindAPI(MIR_SERVER_EGL_OPENGL_API);
-
-            const EGLint image_attrs[] =
-                {
-                    EGL_IMAGE_PRESERVED_KHR, EGL_TRUE,
-                    EGL_NONE
-                };
-
-            egl_image = extensions->eglCreateImageKHR(
-                dpy,
-                EGL_NO_CONTEXT,
-                EGL_WAYLAND_BUFFER_WL,
-                buffer,
-                image_attrs);
-
-            if (egl_image == EGL_NO_IMAGE_KHR)
-                BOOST_THROW_EXCEPTION(mg::egl_error("Failed to create EGLImage"));
+            // Clients cycle a handful of wl_buffers, so import each one once and
+            // share the EGLImage with every WaylandBuffer wrapping it.
+            if (!buffer_state->egl_image)
+                buffer_state->egl_image = std::make_shared<WaylandBufferImage>(dpy, buffer, extensions);
+            egl_image = buffer_state->egl_image;
         }
         lock.unlock();
 
-        extensions->glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, egl_image);
+        extensions->glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, egl_image->image());
     }
 
     void bind() override
@@ -469,7 +506,6 @@ private:
         std::function<void()>&& on_release)
         : buffer{buffer},
         dpy{dpy},
-        egl_image{EGL_NO_IMAGE_KHR},
         extensions{extensions},
         on_consumed{std::move(on_consumed)},
         on_release{std::move(on_release)}
@@ -513,28 +549,37 @@ private:
         shim = wl_container_of(listener, shim, destruction_listener);
 
         {
-            std::lock_guard<std::mutex> lock{*shim->mutex};
+            std::lock_guard<std::mutex> lock{shim->state->mutex};
             if (auto mir_buffer = shim->associated_buffer.lock())
             {
                 mir_buffer->buffer = nullptr;
             }
+            // Any WaylandBuffer still rendering holds its own reference
+            shim->state->egl_image.reset();
         }
 
         delete shim;
     }
 
+    // Shared by every WaylandBuffer created for the same wl_buffer
+    struct BufferState
+    {
+        std::mutex mutex;
+        std::shared_ptr<WaylandBufferImage> egl_image;
+    };
+
     struct DestructionShim
     {
-        std::shared_ptr<std::mutex> const mutex = std::make_shared<std::mutex>();
+        std::shared_ptr<BufferState> const state = std::make_shared<BufferState>();
         std::weak_ptr<WaylandBuffer> associated_buffer;
         wl_listener destruction_listener;
     };
 
-    std::shared_ptr<std::mutex> buffer_mutex;
+    std::shared_ptr<BufferState> buffer_state;
     wl_resource* buffer;
 
     EGLDisplay dpy;
-    EGLImageKHR egl_image;
+    std::shared_ptr<WaylandBufferImage> egl_image;
 
     EGLint width, height;
     MirPixelFormat format;
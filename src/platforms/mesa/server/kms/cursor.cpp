@@ -27,7 +27,9 @@
 #include <xf86drm.h>
 
 #include <boost/exception/errinfo_errno.hpp>
+#include <boost/functional/hash.hpp>
 
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
 
@@ -40,6 +42,20 @@ namespace
 const uint64_t fallback_cursor_size = 64;
 char const* const mir_drm_cursor_64x64 = "MIR_DRM_CURSOR_64x64";
 
+// Enough for a cursor theme's worth of images on a couple of orientations
+size_t const max_padded_images = 64;
+
+size_t hash_image(geom::Size const& size, std::vector<uint8_t> const& argb8888)
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, size.width.as_uint32_t());
+    boost::hash_combine(seed, size.height.as_uint32_t());
+
+    auto const pixels = reinterpret_cast<uint32_t const*>(argb8888.data());
+    boost::hash_range(seed, pixels, pixels + argb8888.size()/4);
+    return seed;
+}
+
 // Transforms a relative position within the display bounds described by \a rect which is rotated with \a orientation
 geom::Displacement transform(geom::Rectangle const& rect, geom::Displacement const& vector, MirOrientation orientation)
 {
@@ -129,7 +145,8 @@ inline mgm::Cursor::GBMBOWrapper::~GBMBOWrapper()
 mgm::Cursor::GBMBOWrapper::GBMBOWrapper(GBMBOWrapper&& from)
     : device{from.device},
       buffer{from.buffer},
-      current_orientation{from.current_orientation}
+      current_orientation{from.current_orientation},
+      current_image{from.current_image}
 {
     from.buffer = nullptr;
     from.device = nullptr;
@@ -141,6 +158,7 @@ auto mir::graphics::mesa::Cursor::GBMBOWrapper::change_orientation(MirOrientatio
         return false;
 
     current_orientation = new_orientation;
+    current_image = optional_value<uint64_t>{};
     return true;
 }
 
@@ -149,6 +167,8 @@ mgm::Cursor::Cursor(
     std::shared_ptr<CurrentConfiguration> const& current_configuration) :
         output_container(output_container),
         current_position(),
+        image_hash{0},
+        image_serial{0},
         last_set_failed(false),
         min_buffer_width{std::numeric_limits<uint32_t>::max()},
         min_buffer_height{std::numeric_limits<uint32_t>::max()},
@@ -208,7 +228,32 @@ void mgm::Cursor::pad_and_write_image_data_locked(
     auto const buffer_height = std::max(min_height, gbm_bo_get_height(buffer));
     size_t const padded_size = buffer_stride * buffer_height;
 
-    auto padded = std::unique_ptr<uint8_t[]>(new uint8_t[padded_size]);
+    auto const cached = std::find_if(padded_images.begin(), padded_images.end(),
+        [&](PaddedImage const& candidate)
+        {
+            return candidate.image_hash == image_hash &&
+                candidate.orientation == orientation &&
+                candidate.buffer_stride == buffer_stride &&
+                candidate.buffer_height == buffer_height &&
+                candidate.size == size &&
+                candidate.argb8888 == argb8888;
+        });
+
+    if (cached != padded_images.end())
+    {
+        padded_images.splice(padded_images.begin(), padded_images, cached);
+        write_buffer_data_locked(lg, buffer, cached->padded.data(), padded_size);
+        buffer.set_image(image_serial);
+        return;
+    }
+
+    if (padded_images.size() >= max_padded_images)
+        padded_images.pop_back();
+
+    padded_images.push_front(
+        PaddedImage{image_hash, size, argb8888, orientation, buffer_stride, buffer_height, {}});
+    auto& padded = padded_images.front().padded;
+    padded.resize(padded_size);
     size_t rhs_padding = buffer_stride - 4*image_width;
 
     auto const filler = 0; // 0x3f; is useful to make buffer visible for debugging
@@ -272,7 +317,8 @@ void mgm::Cursor::pad_and_write_image_data_locked(
         break;
     }
 
-    write_buffer_data_locked(lg, buffer, &padded[0], padded_size);
+    write_buffer_data_locked(lg, buffer, padded.data(), padded_size);
+    buffer.set_image(image_serial);
 }
 
 void mgm::Cursor::show()
@@ -290,17 +336,32 @@ void mgm::Cursor::show(CursorImage const& cursor_image)
 {
     std::lock_guard<std::mutex> lg(guard);
 
-    size = cursor_image.size();
+    auto const new_size = cursor_image.size();
+    auto const image_data = static_cast<uint8_t const*>(cursor_image.as_argb_8888());
+    auto const image_bytes = new_size.width.as_uint32_t() * new_size.height.as_uint32_t() * 4;
 
-    argb8888.resize(size.width.as_uint32_t() * size.height.as_uint32_t() * 4);
-    memcpy(argb8888.data(), cursor_image.as_argb_8888(), argb8888.size());
+    // Clients often set the same image again (e.g. on every hover)
+    bool const same_image =
+        new_size == size &&
+        argb8888.size() == image_bytes &&
+        std::equal(image_data, image_data + image_bytes, argb8888.begin());
+
+    if (!same_image)
+    {
+        size = new_size;
+        argb8888.assign(image_data, image_data + image_bytes);
+        image_hash = hash_image(size, argb8888);
+        ++image_serial;
+    }
 
     hotspot = cursor_image.hotspot();
     {
         auto locked_buffers = buffers.lock();
         for (auto& tuple : *locked_buffers)
         {
-            pad_and_write_image_data_locked(lg, std::get<2>(tuple));
+            auto& buffer = std::get<2>(tuple);
+            if (buffer.image() != image_serial)
+                pad_and_write_image_data_locked(lg, buffer);
         }
     }
 
@@ -438,10 +499,12 @@ mgm::Cursor::GBMBOWrapper& mgm::Cursor::buffer_for_output(KMSOutput const& outpu
     if (gbm_bo_get_width(bo) < min_buffer_width)
     {
         min_buffer_width = gbm_bo_get_width(bo);
+        padded_images.clear();
     }
     if (gbm_bo_get_height(bo) < min_buffer_height)
     {
         min_buffer_height = gbm_bo_get_height(bo);
+        padded_images.clear();
     }
 
     return bo;
@@ -23,6 +23,7 @@
 #include "mir/graphics/cursor.h"
 #include "mir/geometry/point.h"
 #include "mir/geometry/displacement.h"
+#include "mir/optional_value.h"
 
 #include "mir_toolkit/common.h"
 #include "mutex.h"
@@ -30,8 +31,10 @@
 #include <gbm.h>
 
 #include <functional>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <tuple>
 #include <vector>
 
 namespace mir
@@ -108,6 +111,23 @@ private:
     geometry::Displacement hotspot;
     geometry::Size size;
     std::vector<uint8_t> argb8888;
+    size_t image_hash;
+    // Changes whenever show() is given an image that differs from the last one
+    uint64_t image_serial;
+
+    // A padded (and rotated) copy of a recently shown image, ready to write to a buffer
+    struct PaddedImage
+    {
+        size_t image_hash;  // Saves comparing the pixels of most other images
+        geometry::Size size;
+        std::vector<uint8_t> argb8888;
+        MirOrientation orientation;
+        uint32_t buffer_stride;
+        uint32_t buffer_height;
+        std::vector<uint8_t> padded;
+    };
+    // Most recently used first
+    std::list<PaddedImage> padded_images;
 
     bool visible;
     bool last_set_failed;
@@ -120,6 +140,10 @@ private:
         auto orientation() const -> MirOrientation { return current_orientation; }
         auto change_orientation(MirOrientation new_orientation) -> bool;
 
+        // Serial of the image last written to the buffer, if any
+        auto image() const -> optional_value<uint64_t> { return current_image; }
+        void set_image(uint64_t image_serial) { current_image = image_serial; }
+
         ~GBMBOWrapper();
 
         GBMBOWrapper(GBMBOWrapper&& from);
@@ -127,6 +151,7 @@ private:
         gbm_device* device;
         gbm_bo* buffer;
         MirOrientation current_orientation;
+        optional_value<uint64_t> current_image;
         GBMBOWrapper(GBMBOWrapper const&) = delete;
         GBMBOWrapper& operator=(GBMBOWrapper const&) = delete;
     };
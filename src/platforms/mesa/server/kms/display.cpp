@@ -167,6 +167,7 @@ mgm::Display::Display(std::vector<std::shared_ptr<helpers::DRMHelper>> const& dr
                       std::shared_ptr<helpers::GBMHelper> const& gbm,
                       std::shared_ptr<ConsoleServices> const& vt,
                       mgm::BypassOption bypass_option,
+                      mgm::PartialReconfigurationOption partial_reconfiguration_option,
                       std::shared_ptr<DisplayConfigurationPolicy> const& initial_conf_policy,
                       std::shared_ptr<GLConfig> const& gl_config,
                       std::shared_ptr<DisplayReport> const& listener)
@@ -194,6 +195,7 @@ mgm::Display::Display(std::vector<std::shared_ptr<helpers::DRMHelper>> const& dr
       current_display_configuration{output_container},
       dirty_configuration{false},
       bypass_option(bypass_option),
+      partial_reconfiguration_option(partial_reconfiguration_option),
       gl_config{gl_config}
 {
     shared_egl.setup(*gbm);
@@ -453,6 +455,7 @@ void mgm::Display::configure_locked(
         (&kms_conf != &current_display_configuration) &&
         compatible(kms_conf, current_display_configuration)};
     std::vector<std::unique_ptr<DisplayBuffer>> display_buffers_new;
+    decltype(display_buffer_outputs) display_buffer_outputs_new;
 
     if (!comp)
     {
@@ -487,11 +490,13 @@ void mgm::Display::configure_locked(
             auto bounding_rect = group.bounding_rectangle();
             // Each vector<KMSOutput> is a single GPU memory domain
             std::vector<std::vector<std::shared_ptr<KMSOutput>>> kms_output_groups;
+            std::vector<DisplayConfigurationOutput> group_outputs;
             glm::mat2 transformation;
 
             group.for_each_output(
                 [&](DisplayConfigurationOutput const& conf_output)
                 {
+                    group_outputs.push_back(conf_output);
                     auto kms_output = current_display_configuration.get_output_for(conf_output.id);
 
                     auto const mode_index = kms_conf.get_kms_mode_index(conf_output.id,
@@ -513,56 +518,25 @@ void mgm::Display::configure_locked(
 
             if (comp)
             {
+                display_buffer_outputs[group_idx] = group_outputs;
                 display_buffers[group_idx++]->set_transformation(transformation,
                                                                  bounding_rect);
             }
             else
             {
-                glm::vec2 const logical_size{
-                    bounding_rect.size.width.as_uint32_t(),
-                    bounding_rect.size.height.as_uint32_t()};
-
-                auto const physical_size = transformation * logical_size;
-                uint32_t width = abs(int(physical_size.x));
-                uint32_t height = abs(int(physical_size.y));
-
                 for (auto const& group : kms_output_groups)
                 {
-                    /*
-                     * In a hybrid setup a scanout surface needs to be allocated differently if it
-                     * needs to be able to be shared across GPUs. This likely reduces performance.
-                     *
-                     * As a first cut, assume every scanout buffer in a hybrid setup might need
-                     * to be shared.
-                     */
-                    auto surface = gbm->create_scanout_surface(width, height, drm.size() != 1);
-                    auto const raw_surface = surface.get();
-
-                    auto db = std::make_unique<DisplayBuffer>(
-                        bypass_option,
-                        listener,
-                        group,
-                        GBMOutputSurface{
-                            group.front()->drm_fd(),
-                            std::move(surface),
-                            width, height,
-                            helpers::EGLHelper{
-                                *gl_config,
-                                *gbm,
-                                raw_surface,
-                                shared_egl.context()
-                            }
-                        },
-                        bounding_rect,
-                        transformation);
-
-                    display_buffers_new.push_back(std::move(db));
+                    display_buffers_new.push_back(create_display_buffer(group, bounding_rect, transformation));
+                    display_buffer_outputs_new.push_back(group_outputs);
                 }
             }
         });
 
     if (!comp)
+    {
         display_buffers = std::move(display_buffers_new);
+        display_buffer_outputs = std::move(display_buffer_outputs_new);
+    }
 
     /* Store applied configuration */
     current_display_configuration = kms_conf;
@@ -571,3 +545,179 @@ void mgm::Display::configure_locked(
         /* Clear connected but unused outputs */
         clear_connected_unused_outputs();
 }
+
+bool mgm::Display::configure_changed_outputs(
+    mg::DisplayConfiguration const& conf,
+    std::function<void(mg::DisplaySyncGroup&)> const& removing_group)
+{
+    /* Not yet validated on hardware, so only used when asked for */
+    if (partial_reconfiguration_option == mgm::PartialReconfigurationOption::prohibited)
+        return false;
+
+    if (!conf.valid())
+    {
+        BOOST_THROW_EXCEPTION(
+            std::logic_error("Invalid or inconsistent display configuration"));
+    }
+
+    auto const& kms_conf = dynamic_cast<RealKMSDisplayConfiguration const&>(conf);
+
+    {
+        std::lock_guard<decltype(configuration_mutex)> lock{configuration_mutex};
+
+        std::vector<OverlappingOutputGroup> groups;
+        std::vector<std::vector<DisplayConfigurationOutput>> groups_outputs;
+        OverlappingOutputGrouping{kms_conf}.for_each_group(
+            [&](OverlappingOutputGroup const& group)
+            {
+                groups.push_back(group);
+                groups_outputs.emplace_back();
+                group.for_each_output(
+                    [&](DisplayConfigurationOutput const& conf_output)
+                    {
+                        groups_outputs.back().push_back(conf_output);
+                    });
+            });
+
+        auto const unchanged = [&](std::vector<DisplayConfigurationOutput> const& outputs)
+            {
+                return std::find(groups_outputs.begin(), groups_outputs.end(), outputs) != groups_outputs.end();
+            };
+
+        /*
+         * DisplayBuffers driving a group of outputs that is configured exactly as
+         * before are kept, and keep compositing throughout. The others are handed
+         * back and destroyed before anything takes over their outputs.
+         */
+        std::vector<DisplayConfigurationOutputId> kept_outputs;
+        for (auto i = 0u; i != display_buffers.size(); ++i)
+        {
+            if (unchanged(display_buffer_outputs[i]))
+            {
+                for (auto const& conf_output : display_buffer_outputs[i])
+                    kept_outputs.push_back(conf_output.id);
+            }
+            else
+            {
+                removing_group(*display_buffers[i]);
+                display_buffers[i]->wait_for_page_flip();
+                display_buffers[i].reset();
+            }
+        }
+
+        auto const kept = [&](DisplayConfigurationOutputId id)
+            {
+                return std::find(kept_outputs.begin(), kept_outputs.end(), id) != kept_outputs.end();
+            };
+
+        /* Reset the state of the outputs no kept DisplayBuffer is driving */
+        kms_conf.for_each_output(
+            [&](DisplayConfigurationOutput const& conf_output)
+            {
+                if (!kept(conf_output.id))
+                {
+                    auto kms_output = current_display_configuration.get_output_for(conf_output.id);
+                    kms_output->clear_cursor();
+                    kms_output->reset();
+                }
+            });
+
+        /* Keep the DisplayBuffers in grouping order, as configure_locked() relies on it */
+        std::vector<std::unique_ptr<DisplayBuffer>> display_buffers_new;
+        decltype(display_buffer_outputs) display_buffer_outputs_new;
+
+        for (auto g = 0u; g != groups.size(); ++g)
+        {
+            bool reused{false};
+            for (auto i = 0u; i != display_buffers.size(); ++i)
+            {
+                if (display_buffers[i] && display_buffer_outputs[i] == groups_outputs[g])
+                {
+                    display_buffers_new.push_back(std::move(display_buffers[i]));
+                    display_buffer_outputs_new.push_back(groups_outputs[g]);
+                    reused = true;
+                }
+            }
+
+            if (reused)
+                continue;
+
+            auto const bounding_rect = groups[g].bounding_rectangle();
+            std::vector<std::vector<std::shared_ptr<KMSOutput>>> kms_output_groups;
+            glm::mat2 transformation;
+
+            for (auto const& conf_output : groups_outputs[g])
+            {
+                auto kms_output = current_display_configuration.get_output_for(conf_output.id);
+
+                auto const mode_index = kms_conf.get_kms_mode_index(conf_output.id,
+                                                                    conf_output.current_mode_index);
+                kms_output->configure(conf_output.top_left - bounding_rect.top_left, mode_index);
+                kms_output->set_power_mode(conf_output.power_mode);
+                kms_output->set_gamma(conf_output.gamma);
+                add_to_drm_device_group(kms_output_groups, std::move(kms_output));
+                transformation = conf_output.transformation();
+            }
+
+            for (auto const& group : kms_output_groups)
+            {
+                display_buffers_new.push_back(create_display_buffer(group, bounding_rect, transformation));
+                display_buffer_outputs_new.push_back(groups_outputs[g]);
+            }
+        }
+
+        display_buffers = std::move(display_buffers_new);
+        display_buffer_outputs = std::move(display_buffer_outputs_new);
+
+        /* Store applied configuration */
+        current_display_configuration = kms_conf;
+
+        /* Clear connected but unused outputs */
+        clear_connected_unused_outputs();
+    }
+
+    if (auto c = cursor.lock()) c->resume();
+    return true;
+}
+
+auto mgm::Display::create_display_buffer(
+    std::vector<std::shared_ptr<KMSOutput>> const& outputs,
+    geom::Rectangle const& area,
+    glm::mat2 const& transformation) -> std::unique_ptr<DisplayBuffer>
+{
+    glm::vec2 const logical_size{
+        area.size.width.as_uint32_t(),
+        area.size.height.as_uint32_t()};
+
+    auto const physical_size = transformation * logical_size;
+    uint32_t width = abs(int(physical_size.x));
+    uint32_t height = abs(int(physical_size.y));
+
+    /*
+     * In a hybrid setup a scanout surface needs to be allocated differently if it
+     * needs to be able to be shared across GPUs. This likely reduces performance.
+     *
+     * As a first cut, assume every scanout buffer in a hybrid setup might need
+     * to be shared.
+     */
+    auto surface = gbm->create_scanout_surface(width, height, drm.size() != 1);
+    auto const raw_surface = surface.get();
+
+    return std::make_unique<DisplayBuffer>(
+        bypass_option,
+        listener,
+        outputs,
+        GBMOutputSurface{
+            outputs.front()->drm_fd(),
+            std::move(surface),
+            width, height,
+            helpers::EGLHelper{
+                *gl_config,
+                *gbm,
+                raw_surface,
+                shared_egl.context()
+            }
+        },
+        area,
+        transformation);
+}
@@ -69,6 +69,7 @@ public:
             std::shared_ptr<helpers::GBMHelper> const& gbm,
             std::shared_ptr<ConsoleServices> const& vt,
             BypassOption bypass_option,
+            PartialReconfigurationOption partial_reconfiguration_option,
             std::shared_ptr<DisplayConfigurationPolicy> const& initial_conf_policy,
             std::shared_ptr<GLConfig> const& gl_config,
             std::shared_ptr<DisplayReport> const& listener);
@@ -81,6 +82,9 @@ public:
     std::unique_ptr<DisplayConfiguration> configuration() const override;
     bool apply_if_configuration_preserves_display_buffers(DisplayConfiguration const& conf) override;
     void configure(DisplayConfiguration const& conf) override;
+    bool configure_changed_outputs(
+        DisplayConfiguration const& conf,
+        std::function<void(DisplaySyncGroup&)> const& removing_group) override;
 
     void register_configuration_change_handler(
         EventHandlerRegister& handlers,
@@ -120,8 +124,16 @@ private:
     void configure_locked(
         RealKMSDisplayConfiguration const& conf,
         std::lock_guard<decltype(configuration_mutex)> const&);
+    std::unique_ptr<DisplayBuffer> create_display_buffer(
+        std::vector<std::shared_ptr<KMSOutput>> const& outputs,
+        geometry::Rectangle const& area,
+        glm::mat2 const& transformation);
+
+    /// The configuration of the overlapping output group each of display_buffers was created for
+    std::vector<std::vector<DisplayConfigurationOutput>> display_buffer_outputs;
 
     BypassOption bypass_option;
+    PartialReconfigurationOption const partial_reconfiguration_option;
     std::weak_ptr<Cursor> cursor;
     std::shared_ptr<GLConfig> const gl_config;
 };
@@ -54,7 +54,8 @@ namespace mgmh = mgm::helpers;
 mgm::Platform::Platform(std::shared_ptr<DisplayReport> const& listener,
                         std::shared_ptr<ConsoleServices> const& vt,
                         EmergencyCleanupRegistry&,
-                        BypassOption bypass_option)
+                        BypassOption bypass_option,
+                        PartialReconfigurationOption partial_reconfiguration_option)
     : udev{std::make_shared<mir::udev::Context>()},
       drm{helpers::DRMHelper::open_all_devices(udev, *vt)},
       // We assume the first DRM device is the boot GPU, and arbitrarily pick it as our
@@ -64,7 +65,8 @@ mgm::Platform::Platform(std::shared_ptr<DisplayReport> const& listener,
       gbm{std::make_shared<mgmh::GBMHelper>(drm.front()->fd)},
       listener{listener},
       vt{vt},
-      bypass_option_{bypass_option}
+      bypass_option_{bypass_option},
+      partial_reconfiguration_option_{partial_reconfiguration_option}
 {
     auth_factory = std::make_unique<DRMNativePlatformAuthFactory>(*drm.front());
 }
@@ -82,6 +84,7 @@ mir::UniqueModulePtr<mg::Display> mgm::Platform::create_display(
         gbm,
         vt,
         bypass_option_,
+        partial_reconfiguration_option_,
         initial_conf_policy,
         gl_config,
         listener);
@@ -112,6 +115,11 @@ mgm::BypassOption mgm::Platform::bypass_option() const
     return bypass_option_;
 }
 
+mgm::PartialReconfigurationOption mgm::Platform::partial_reconfiguration_option() const
+{
+    return partial_reconfiguration_option_;
+}
+
 std::vector<mir::ExtensionDescription> mgm::Platform::extensions() const
 {
     return mgm::mesa_extensions();
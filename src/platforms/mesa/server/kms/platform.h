@@ -44,7 +44,8 @@ public:
     explicit Platform(std::shared_ptr<DisplayReport> const& reporter,
                       std::shared_ptr<ConsoleServices> const& vt,
                       EmergencyCleanupRegistry& emergency_cleanup_registry,
-                      BypassOption bypass_option);
+                      BypassOption bypass_option,
+                      PartialReconfigurationOption partial_reconfiguration_option);
 
     /* From Platform */
     UniqueModulePtr<graphics::GraphicBufferAllocator> create_buffer_allocator() override;
@@ -67,8 +68,10 @@ public:
     std::shared_ptr<ConsoleServices> const vt;
 
     BypassOption bypass_option() const;
+    PartialReconfigurationOption partial_reconfiguration_option() const;
 private:
     BypassOption const bypass_option_;
+    PartialReconfigurationOption const partial_reconfiguration_option_;
     std::unique_ptr<DRMNativePlatformAuthFactory> auth_factory;
 };
 
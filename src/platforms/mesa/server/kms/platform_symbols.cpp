@@ -48,6 +48,7 @@ namespace mo = mir::options;
 namespace
 {
 char const* bypass_option_name{"bypass"};
+char const* partial_reconfiguration_option_name{"partial-reconfiguration"};
 char const* host_socket{"host-socket"};
 
 }
@@ -66,8 +67,12 @@ mir::UniqueModulePtr<mg::Platform> create_host_platform(
     if (!options->get<bool>(bypass_option_name))
         bypass_option = mgm::BypassOption::prohibited;
 
+    auto partial_reconfiguration_option = mgm::PartialReconfigurationOption::prohibited;
+    if (options->get<bool>(partial_reconfiguration_option_name))
+        partial_reconfiguration_option = mgm::PartialReconfigurationOption::allowed;
+
     return mir::make_module_ptr<mgm::Platform>(
-        report, console, *emergency_cleanup_registry, bypass_option);
+        report, console, *emergency_cleanup_registry, bypass_option, partial_reconfiguration_option);
 }
 
 void add_graphics_platform_options(boost::program_options::options_description& config)
@@ -76,7 +81,11 @@ void add_graphics_platform_options(boost::program_options::options_description&
     config.add_options()
         (bypass_option_name,
          boost::program_options::value<bool>()->default_value(true),
-         "[platform-specific] utilize the bypass optimization for fullscreen surfaces.");
+         "[platform-specific] utilize the bypass optimization for fullscreen surfaces.")
+        (partial_reconfiguration_option_name,
+         boost::program_options::value<bool>()->default_value(false),
+         "[platform-specific] reconfigure only the outputs that change, letting the others "
+         "keep compositing. Experimental.");
 }
 
 namespace
@@ -231,8 +240,12 @@ mir::UniqueModulePtr<mir::graphics::DisplayPlatform> create_display_platform(
     if (!options->get<bool>(bypass_option_name))
         bypass_option = mgm::BypassOption::prohibited;
 
+    auto partial_reconfiguration_option = mgm::PartialReconfigurationOption::prohibited;
+    if (options->get<bool>(partial_reconfiguration_option_name))
+        partial_reconfiguration_option = mgm::PartialReconfigurationOption::allowed;
+
     return mir::make_module_ptr<mgm::Platform>(
-        report, console, *emergency_cleanup_registry, bypass_option);
+        report, console, *emergency_cleanup_registry, bypass_option, partial_reconfiguration_option);
 }
 
 mir::UniqueModulePtr<mir::graphics::RenderingPlatform> create_rendering_platform(
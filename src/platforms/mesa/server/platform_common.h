@@ -32,6 +32,12 @@ enum class BypassOption
     prohibited
 };
 
+enum class PartialReconfigurationOption
+{
+    allowed,
+    prohibited
+};
+
 }
 }
 }
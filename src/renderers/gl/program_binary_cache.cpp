@@ -0,0 +1,222 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define MIR_LOG_COMPONENT "GLRenderer"
+
+#include "program_binary_cache.h"
+#include "mir/graphics/gl_extensions_base.h"
+#include "mir/log.h"
+
+#include MIR_SERVER_GLEXT_H
+#include <EGL/egl.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <vector>
+
+#include <unistd.h>
+
+#ifndef GL_PROGRAM_BINARY_LENGTH_OES
+#define GL_PROGRAM_BINARY_LENGTH_OES 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS_OES
+#define GL_NUM_PROGRAM_BINARY_FORMATS_OES 0x87FE
+#endif
+
+namespace mrg = mir::renderer::gl;
+
+namespace
+{
+char const magic[] = "MIRPRGB1";
+uint32_t const max_entry_size{16 * 1024 * 1024};
+
+char const* const cache_dir_env = "MIR_SHADER_CACHE_DIR";
+
+std::string default_directory()
+{
+    if (auto const cache_dir = getenv(cache_dir_env))
+        return cache_dir;
+    else if (auto const cache_home = getenv("XDG_CACHE_HOME"))
+        return std::string{cache_home} + "/mir/shaders";
+    else if (auto const home = getenv("HOME"))
+        return std::string{home} + "/.cache/mir/shaders";
+
+    return {};
+}
+
+std::string gl_string(GLenum name)
+{
+    auto const value = reinterpret_cast<char const*>(glGetString(name));
+    return value ? value : "";
+}
+
+bool read_u32(std::istream& in, uint32_t& value)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof value));
+}
+
+void write_u32(std::ostream& out, uint32_t value)
+{
+    out.write(reinterpret_cast<char const*>(&value), sizeof value);
+}
+}
+
+mrg::ProgramBinaryCache::ProgramBinaryCache() :
+    ProgramBinaryCache{default_directory()}
+{
+}
+
+mrg::ProgramBinaryCache::ProgramBinaryCache(std::string const& directory) :
+    directory{directory}
+{
+}
+
+bool mrg::ProgramBinaryCache::available()
+{
+    if (!probed)
+    {
+        probed = true;
+
+        auto const extensions = glGetString(GL_EXTENSIONS);
+        GLint formats{0};
+
+        if (!directory.empty() &&
+            extensions &&
+            mir::graphics::GLExtensionsBase{reinterpret_cast<char const*>(extensions)}.support("GL_OES_get_program_binary") &&
+            (glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_OES, &formats), formats > 0))
+        {
+            get_program_binary = reinterpret_cast<GetProgramBinary>(eglGetProcAddress("glGetProgramBinaryOES"));
+            program_binary = reinterpret_cast<ProgramBinary>(eglGetProcAddress("glProgramBinaryOES"));
+            driver = gl_string(GL_VENDOR) + '\n' + gl_string(GL_RENDERER) + '\n' + gl_string(GL_VERSION);
+        }
+    }
+
+    return get_program_binary && program_binary;
+}
+
+std::string mrg::ProgramBinaryCache::key_for(GLchar const* vshader_src, GLchar const* fshader_src) const
+{
+    return driver + '\0' + vshader_src + '\0' + fshader_src;
+}
+
+std::string mrg::ProgramBinaryCache::path_for(std::string const& key) const
+{
+    std::ostringstream path;
+    path << directory << '/' << std::hex << std::hash<std::string>{}(key) << ".bin";
+    return path.str();
+}
+
+bool mrg::ProgramBinaryCache::load(GLuint program, GLchar const* vshader_src, GLchar const* fshader_src)
+{
+    if (!available())
+        return false;
+
+    auto const key = key_for(vshader_src, fshader_src);
+    auto const path = path_for(key);
+
+    std::ifstream in{path, std::ios::binary};
+    if (!in)
+        return false;
+
+    char file_magic[sizeof magic - 1];
+    uint32_t format, key_size, binary_size;
+
+    if (!in.read(file_magic, sizeof file_magic) ||
+        !std::equal(file_magic, file_magic + sizeof file_magic, magic) ||
+        !read_u32(in, format) ||
+        !read_u32(in, key_size) || key_size != key.size())
+    {
+        return false;
+    }
+
+    std::string file_key(key_size, '\0');
+    if (!in.read(&file_key[0], key_size) || file_key != key ||
+        !read_u32(in, binary_size) || binary_size == 0 || binary_size > max_entry_size)
+    {
+        return false;
+    }
+
+    std::vector<char> binary(binary_size);
+    if (!in.read(binary.data(), binary_size))
+        return false;
+
+    program_binary(program, format, binary.data(), binary_size);
+
+    GLint linked{GL_FALSE};
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE)
+    {
+        // Typically a driver update that kept the same version strings
+        mir::log_debug("Discarding stale GL program binary %s", path.c_str());
+        std::remove(path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void mrg::ProgramBinaryCache::store(GLuint program, GLchar const* vshader_src, GLchar const* fshader_src)
+{
+    if (!available())
+        return;
+
+    GLint length{0};
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_OES, &length);
+    if (length <= 0 || static_cast<uint32_t>(length) > max_entry_size)
+        return;
+
+    std::vector<char> binary(length);
+    GLsizei written{0};
+    GLenum format{0};
+    get_program_binary(program, length, &written, &format, binary.data());
+    if (written <= 0)
+        return;
+
+    auto const key = key_for(vshader_src, fshader_src);
+    auto const path = path_for(key);
+    auto const temporary = path + "." + std::to_string(getpid()) + ".tmp";
+
+    boost::system::error_code ignored;
+    boost::filesystem::create_directories(directory, ignored);
+
+    std::ofstream out{temporary, std::ios::binary | std::ios::trunc};
+    out.write(magic, sizeof magic - 1);
+    write_u32(out, format);
+    write_u32(out, key.size());
+    out.write(key.data(), key.size());
+    write_u32(out, written);
+    out.write(binary.data(), written);
+
+    // Flushing on close() can fail too (e.g. a full disk), so check afterwards
+    out.close();
+    if (!out)
+    {
+        mir::log_debug("Failed to write GL program binary cache %s", temporary.c_str());
+        std::remove(temporary.c_str());
+        return;
+    }
+
+    // Replace atomically so a concurrent reader never sees a partial entry
+    if (std::rename(temporary.c_str(), path.c_str()) != 0)
+        std::remove(temporary.c_str());
+}
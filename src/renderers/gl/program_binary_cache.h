@@ -0,0 +1,79 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_RENDERER_GL_PROGRAM_BINARY_CACHE_H_
+#define MIR_RENDERER_GL_PROGRAM_BINARY_CACHE_H_
+
+#include MIR_SERVER_GL_H
+
+#include <string>
+
+namespace mir
+{
+namespace renderer
+{
+namespace gl
+{
+
+/**
+ * Keeps linked GLSL program binaries on disk (GL_OES_get_program_binary) so
+ * later runs can skip compiling and linking shaders.
+ *
+ * Entries are keyed by the GL vendor, renderer and version strings and the
+ * shader sources. Anything unreadable, mismatched or rejected by the driver
+ * is ignored and the caller falls back to compiling from source.
+ *
+ * The GL context must be current when load() and store() are called.
+ */
+class ProgramBinaryCache
+{
+public:
+    /// Caches in $MIR_SHADER_CACHE_DIR if that is set (an empty value disables
+    /// the cache), otherwise in $XDG_CACHE_HOME/mir/shaders or ~/.cache/mir/shaders
+    ProgramBinaryCache();
+    /// Caches in directory; an empty directory disables the cache
+    explicit ProgramBinaryCache(std::string const& directory);
+
+    ProgramBinaryCache(ProgramBinaryCache const&) = delete;
+    ProgramBinaryCache& operator=(ProgramBinaryCache const&) = delete;
+
+    /// Returns true if program has been linked from a cached binary
+    bool load(GLuint program, GLchar const* vshader_src, GLchar const* fshader_src);
+
+    /// Saves the binary of the (successfully linked) program
+    void store(GLuint program, GLchar const* vshader_src, GLchar const* fshader_src);
+
+private:
+    typedef void (*GetProgramBinary)(GLuint, GLsizei, GLsizei*, GLenum*, void*);
+    typedef void (*ProgramBinary)(GLuint, GLenum, void const*, GLint);
+
+    bool available();
+    std::string key_for(GLchar const* vshader_src, GLchar const* fshader_src) const;
+    std::string path_for(std::string const& key) const;
+
+    std::string const directory;
+
+    bool probed{false};
+    GetProgramBinary get_program_binary{nullptr};
+    ProgramBinary program_binary{nullptr};
+    std::string driver;
+};
+
+}
+}
+}
+
+#endif // MIR_RENDERER_GL_PROGRAM_BINARY_CACHE_H_
@@ -89,16 +89,19 @@ GLuint ProgramFamily::add_program(const GLchar* const vshader_src,
     static std::mutex lp1416482_mutex;
     std::lock_guard<decltype(lp1416482_mutex)> lock{lp1416482_mutex};
 
-    auto& v = vshader[vshader_src];
-    if (!v.id) v.init(GL_VERTEX_SHADER, vshader_src);
-
-    auto& f = fshader[fshader_src];
-    if (!f.id) f.init(GL_FRAGMENT_SHADER, fshader_src);
-
-    auto& p = program[{v.id, f.id}];
+    auto& p = program[{vshader_src, fshader_src}];
     if (!p.id)
     {
         p.id = glCreateProgram();
+        if (binary_cache.load(p.id, vshader_src, fshader_src))
+            return p.id;
+
+        auto& v = vshader[vshader_src];
+        if (!v.id) v.init(GL_VERTEX_SHADER, vshader_src);
+
+        auto& f = fshader[fshader_src];
+        if (!f.id) f.init(GL_FRAGMENT_SHADER, fshader_src);
+
         glAttachShader(p.id, v.id);
         glAttachShader(p.id, f.id);
         glLinkProgram(p.id);
@@ -113,6 +116,8 @@ GLuint ProgramFamily::add_program(const GLchar* const vshader_src,
             p.id = 0;
             throw std::runtime_error(std::string("Link failed: ")+log);
         }
+
+        binary_cache.store(p.id, vshader_src, fshader_src);
     }
 
     return p.id;
@@ -19,6 +19,8 @@
 #ifndef MIR_RENDERER_GL_PROGRAM_FAMILY_H_
 #define MIR_RENDERER_GL_PROGRAM_FAMILY_H_
 
+#include "program_binary_cache.h"
+
 #include MIR_SERVER_GL_H
 #include <utility>
 #include <map>
@@ -59,12 +61,14 @@ private:
     typedef std::unordered_map<const GLchar*, Shader> ShaderMap;
     ShaderMap vshader, fshader;
 
-    typedef std::pair<GLuint, GLuint> ShaderPair;
+    typedef std::pair<const GLchar*, const GLchar*> SourcePair;
     struct Program
     {
         GLuint id = 0;
     };
-    std::map<ShaderPair, Program> program;
+    std::map<SourcePair, Program> program;
+
+    ProgramBinaryCache binary_cache;
 };
 
 }
@@ -28,14 +28,19 @@
 #include "mir/compositor/display_buffer_compositor_factory.h"
 #include "mir/graphics/transformation.h"
 #include "mir/compositor/display_buffer_compositor.h"
+#include "mir/compositor/scene.h"
+#include "mir/scene/legacy_scene_change_notification.h"
 #include "mir/geometry/rectangles.h"
 #include "mir/raii.h"
 
 #include <boost/throw_exception.hpp>
 
+#include <atomic>
+
 namespace mc = mir::compositor;
 namespace mf = mir::frontend;
 namespace mg = mir::graphics;
+namespace ms = mir::scene;
 namespace geom = mir::geometry;
 
 namespace
@@ -81,18 +86,29 @@ public:
       display_buffer{std::make_unique<ScreencastDisplayBuffer>(capture_region, capture_size, mirror_mode, free_queue, ready_queue, display)},
       display_buffer_compositor{db_compositor_factory.create_compositor_for(*display_buffer)},
       virtual_output{make_virtual_output(display, capture_region)},
+      capture_region(capture_region),
       queue_size(capture_size),
-      mirror_mode(mirror_mode)
+      mirror_mode(mirror_mode),
+      scene_generation{1},
+      observer{std::make_shared<ms::LegacySceneChangeNotification>(
+          [this] { ++scene_generation; },
+          [this](int, geom::Rectangle const& damage)
+          {
+              if (damage.overlaps(this->capture_region))
+                  ++scene_generation;
+          })}
     {
         for (auto buffer : buffers)
             free_queue.schedule(buffer);
 
         scene->register_compositor(this);
+        scene->add_observer(observer);
         if (virtual_output)
             virtual_output->enable();
     }
     ~ScreencastSessionContext()
     {
+        scene->remove_observer(observer);
         scene->unregister_compositor(this);
     }
 
@@ -116,6 +132,21 @@ public:
     void capture(std::shared_ptr<mg::Buffer> const& buffer)
     {
         std::lock_guard<decltype(mutex)> lk(mutex);
+
+        // Clients cycle a fixed set of buffers through here. If nothing in the
+        // captured region has changed since this buffer was last composited
+        // into, its contents are still current and we can skip the composite.
+        forget_released_buffers();
+
+        auto const generation = scene_generation.load();
+        auto const composited = composited_buffers.find(buffer->id());
+        if (composited != composited_buffers.end() &&
+            composited->second.generation == generation &&
+            scene->frames_pending(this) == 0)
+        {
+            return;
+        }
+
         if (buffer->size() != display_buffer->renderbuffer_size())
             display_buffer->set_renderbuffer_size(buffer->size());
        
@@ -144,9 +175,23 @@ public:
 
         display_buffer->set_transformation(mg::transformation(mirror_mode));
         display_buffer->commit();
+
+        composited_buffers[buffer->id()] = {buffer, generation};
     }
 
 private:
+    void forget_released_buffers()
+    {
+        for (auto i = composited_buffers.begin(); i != composited_buffers.end();)
+        {
+            if (i->second.buffer.expired())
+                i = composited_buffers.erase(i);
+            else
+                ++i;
+        }
+    }
+
+
     std::mutex mutex;
     std::shared_ptr<Scene> const scene;
     QueueingSchedule free_queue;
@@ -156,8 +201,19 @@ private:
     std::unique_ptr<compositor::DisplayBufferCompositor> display_buffer_compositor;
     std::unique_ptr<graphics::VirtualOutput> virtual_output;
     std::shared_ptr<mg::Buffer> last_captured_buffer;
+    geom::Rectangle const capture_region;
     geom::Size queue_size;
     MirMirrorMode mirror_mode;
+
+    // Bumped whenever the scene changes in a way that may affect the captured region
+    std::atomic<uint64_t> scene_generation;
+    struct CompositedBuffer
+    {
+        std::weak_ptr<mg::Buffer> buffer;
+        uint64_t generation;
+    };
+    std::unordered_map<mg::BufferID, CompositedBuffer> composited_buffers;
+    std::shared_ptr<ms::LegacySceneChangeNotification> const observer;
 };
 
 
@@ -32,6 +32,8 @@
 #include "mir/unwind_helpers.h"
 #include "mir/thread_name.h"
 
+#include <algorithm>
+#include <iterator>
 #include <thread>
 #include <chrono>
 #include <condition_variable>
@@ -222,6 +224,11 @@ public:
         run_cv.notify_one();
     }
 
+    bool composites(mg::DisplaySyncGroup const& other) const
+    {
+        return &group == &other;
+    }
+
     void wait_until_started()
     {
         if (started_future.wait_for(10s) != std::future_status::ready)
@@ -361,6 +368,105 @@ void mc::MultiThreadedCompositor::stop()
     state = CompositorState::stopped;
 }
 
+void mc::MultiThreadedCompositor::update_compositing_threads(std::function<void()> const& update)
+{
+    if (state != CompositorState::started)
+    {
+        update();
+        return;
+    }
+
+    /*
+     * Scene notifications walk thread_functors without locking, so stop them
+     * while it changes. Compositing carries on meanwhile, and once notifications
+     * resume every output composites once to catch up on anything missed.
+     */
+    auto const paused = mir::raii::paired_calls(
+        [this] { scene->remove_observer(observer); },
+        [this] { scene->add_observer(observer); schedule_compositing(1); });
+
+    update();
+}
+
+void mc::MultiThreadedCompositor::remove_display_sync_group(mg::DisplaySyncGroup& group)
+{
+    std::unique_ptr<CompositingFunctor> functor;
+    std::future<void> future;
+
+    update_compositing_threads([&]
+        {
+            auto const found = std::find_if(begin(thread_functors), end(thread_functors),
+                [&group](std::unique_ptr<CompositingFunctor> const& f) { return f->composites(group); });
+
+            if (found == end(thread_functors))
+                return;
+
+            auto const index = found - begin(thread_functors);
+            functor = std::move(*found);
+            future = std::move(futures[index]);
+            thread_functors.erase(found);
+            futures.erase(begin(futures) + index);
+        });
+
+    if (!functor)
+        return;
+
+    /* The other compositing threads keep running while this one finishes */
+    functor->stop();
+    future.wait();
+
+    thread_pool.shrink();
+}
+
+void mc::MultiThreadedCompositor::add_display_sync_groups()
+{
+    if (state != CompositorState::started)
+        return;
+
+    std::vector<std::unique_ptr<CompositingFunctor>> new_functors;
+    std::vector<std::future<void>> new_futures;
+
+    /* If any new thread fails to start, don't leave the others running */
+    auto cleanup_if_unwinding = on_unwind([&]
+        {
+            for (auto& f : new_functors)
+                if (f) f->stop();
+
+            for (auto& f : new_futures)
+                if (f.valid()) f.wait();
+        });
+
+    display->for_each_display_sync_group([&](mg::DisplaySyncGroup& group)
+    {
+        for (auto const& f : thread_functors)
+        {
+            if (f->composites(group))
+                return;
+        }
+
+        auto thread_functor = std::make_unique<mc::CompositingFunctor>(
+            display_buffer_compositor_factory, group, scene, display_listener,
+            fixed_composite_delay, report);
+
+        new_futures.push_back(thread_pool.run(std::ref(*thread_functor), &group));
+        new_functors.push_back(std::move(thread_functor));
+    });
+
+    if (new_functors.empty())
+        return;
+
+    for (auto& functor : new_functors)
+        functor->wait_until_started();
+
+    update_compositing_threads([&]
+        {
+            std::move(begin(new_functors), end(new_functors), back_inserter(thread_functors));
+            std::move(begin(new_futures), end(new_futures), back_inserter(futures));
+            new_functors.clear();
+            new_futures.clear();
+        });
+}
+
 void mc::MultiThreadedCompositor::create_compositing_threads()
 {
     /* Start the display buffer compositing threads */
@@ -28,6 +28,7 @@
 #include <future>
 #include <chrono>
 #include <atomic>
+#include <functional>
 
 namespace mir
 {
@@ -35,6 +36,7 @@ namespace geometry { struct Rectangle; }
 namespace graphics
 {
 class Display;
+class DisplaySyncGroup;
 }
 namespace scene
 {
@@ -74,9 +76,13 @@ public:
     void start();
     void stop();
 
+    void remove_display_sync_group(graphics::DisplaySyncGroup& group) override;
+    void add_display_sync_groups() override;
+
 private:
     void create_compositing_threads();
     void destroy_compositing_threads();
+    void update_compositing_threads(std::function<void()> const& update);
 
     std::shared_ptr<graphics::Display> const display;
     std::shared_ptr<Scene> const scene;
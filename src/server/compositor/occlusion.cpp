@@ -17,10 +17,12 @@
  */
 
 #include "mir/geometry/rectangle.h"
+#include "mir/geometry/displacement.h"
 #include "mir/compositor/scene_element.h"
 #include "mir/graphics/renderable.h"
 #include "occlusion.h"
 
+#include <algorithm>
 #include <vector>
 
 using namespace mir::geometry;
@@ -29,10 +31,76 @@ using namespace mir::compositor;
 
 namespace
 {
+/*
+ * The opaque rectangles found so far, indexed by a coarse grid over the
+ * output. A rectangle containing a window must contain the window's top-left
+ * corner, so only those registered in that corner's tile need checking. This
+ * keeps large scenes on large outputs from degrading to comparing every
+ * window against every window above it.
+ */
+class Coverage
+{
+public:
+    explicit Coverage(Rectangle const& area) :
+        area{area},
+        tile_width{std::max(1, (area.size.width.as_int() + tiles_per_side - 1) / tiles_per_side)},
+        tile_height{std::max(1, (area.size.height.as_int() + tiles_per_side - 1) / tiles_per_side)},
+        tiles(tiles_per_side * tiles_per_side)
+    {
+    }
+
+    // Precondition: window is non-empty and within area
+    bool contains(Rectangle const& window) const
+    {
+        for (auto const& r : tile_at(window.top_left))
+        {
+            if (r.contains(window))
+                return true;
+        }
+
+        return false;
+    }
+
+    // Precondition: rect is non-empty and within area
+    void add(Rectangle const& rect)
+    {
+        auto const last = rect.bottom_right() - Displacement{1, 1};
+
+        for (auto row = row_of(rect.top_left.y); row <= row_of(last.y); ++row)
+        {
+            for (auto column = column_of(rect.top_left.x); column <= column_of(last.x); ++column)
+                tiles[row * tiles_per_side + column].push_back(rect);
+        }
+    }
+
+private:
+    static int const tiles_per_side = 8;
+
+    int column_of(X x) const
+    {
+        return std::min(tiles_per_side - 1, (x.as_int() - area.top_left.x.as_int()) / tile_width);
+    }
+
+    int row_of(Y y) const
+    {
+        return std::min(tiles_per_side - 1, (y.as_int() - area.top_left.y.as_int()) / tile_height);
+    }
+
+    std::vector<Rectangle> const& tile_at(Point const& point) const
+    {
+        return tiles[row_of(point.y) * tiles_per_side + column_of(point.x)];
+    }
+
+    Rectangle const area;
+    int const tile_width;
+    int const tile_height;
+    std::vector<std::vector<Rectangle>> tiles;
+};
+
 bool renderable_is_occluded(
     Renderable const& renderable, 
     Rectangle const& area,
-    std::vector<Rectangle>& coverage)
+    Coverage& coverage)
 {
     static glm::mat4 const identity(1);
     static Rectangle const empty{};
@@ -46,18 +114,10 @@ bool renderable_is_occluded(
     if (clipped_window == empty)
         return true;  // Not in the area; definitely occluded.
 
-    bool occluded = false;
-    for (auto const& r : coverage)
-    {
-        if (r.contains(clipped_window))
-        {
-            occluded = true;
-            break;
-        }
-    }
+    bool const occluded = coverage.contains(clipped_window);
 
     if (!occluded && renderable.alpha() == 1.0f && !renderable.shaped())
-        coverage.push_back(clipped_window);
+        coverage.add(clipped_window);
 
     return occluded;
 }
@@ -67,23 +127,19 @@ SceneElementSequence mir::compositor::filter_occlusions_from(
     SceneElementSequence& elements,
     Rectangle const& area)
 {
+    Coverage coverage{area};
+    std::vector<bool> is_occluded(elements.size());
+
+    for (auto i = elements.size(); i-- != 0;)
+        is_occluded[i] = renderable_is_occluded(*elements[i]->renderable(), area, coverage);
+
+    SceneElementSequence visible;
     SceneElementSequence occluded;
-    std::vector<Rectangle> coverage;
 
-    auto it = elements.rbegin();
-    while (it != elements.rend())
-    {
-        auto const renderable = (*it)->renderable();
-        if (renderable_is_occluded(*renderable, area, coverage))
-        {
-            occluded.insert(occluded.begin(), *it);
-            it = SceneElementSequence::reverse_iterator(elements.erase(std::prev(it.base())));
-        }
-        else
-        {
-            it++;
-        }
-    }
+    for (size_t i = 0; i != elements.size(); ++i)
+        (is_occluded[i] ? occluded : visible).push_back(std::move(elements[i]));
+
+    elements = std::move(visible);
 
     return occluded;
 }
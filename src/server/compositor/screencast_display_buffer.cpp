@@ -165,9 +165,10 @@ void mc::ScreencastDisplayBuffer::swap_buffers()
 {
     if (current_buffer)
     {
-        //TODO: replace this with a fence which the client could use
-        //to wait for rendering completion
-        glFinish();
+        //TODO: hand the fence to the client rather than waiting for
+        //rendering to complete here
+        render_fence.raise();
+        render_fence.wait();
 
         commit();
 
@@ -20,6 +20,7 @@
 #define MIR_COMPOSITOR_SCREENCAST_DISPLAY_BUFFER_H_
 
 #include "mir/graphics/display_buffer.h"
+#include "mir/graphics/egl_sync_fence.h"
 #include "mir/renderer/gl/render_target.h"
 
 #include MIR_SERVER_GL_H
@@ -138,6 +139,7 @@ private:
     detail::GLResource<glDeleteFramebuffers> fbo;
 
     geometry::Size current_size;
+    graphics::EGLSyncFence render_fence;
 };
 
 }
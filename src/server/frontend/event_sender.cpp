@@ -56,7 +56,7 @@ void mfd::EventSender::handle_event(EventUPtr&& event)
     // containing other responses, but for now we send them individually.
     mp::EventSequence seq;
     mp::Event *ev = seq.add_event();
-    ev->set_raw(MirEvent::serialize(event.get()));
+    MirEvent::serialize(event.get(), *ev->mutable_raw());
 
     send_event_sequence(seq, {});
 }
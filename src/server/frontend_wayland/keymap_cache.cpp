@@ -0,0 +1,190 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keymap_cache.h"
+
+#include "mir/anonymous_shm_file.h"
+#include "mir/input/keymap.h"
+
+#include <xkbcommon/xkbcommon.h>
+#include <boost/throw_exception.hpp>
+
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <linux/memfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS 1033
+#define F_SEAL_SEAL 0x0001
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#define F_SEAL_WRITE 0x0008
+#endif
+
+namespace mf = mir::frontend;
+
+namespace
+{
+// Unused keymaps beyond this many are dropped when a new one is compiled
+size_t const max_cached_keymaps = 8;
+
+/// Returns an invalid Fd if the kernel can't provide a sealed memfd
+mir::Fd sealed_copy_of(std::string const& text)
+{
+    mir::Fd fd{static_cast<int>(syscall(SYS_memfd_create, "mir-keymap", MFD_CLOEXEC | MFD_ALLOW_SEALING))};
+    if (fd < 0)
+        return {};
+
+    if (ftruncate(fd, text.size()) < 0)
+        return {};
+
+    for (size_t written = 0; written < text.size();)
+    {
+        auto const result = pwrite(fd, text.data() + written, text.size() - written, written);
+        if (result < 0 && errno != EINTR)
+            return {};
+        if (result > 0)
+            written += result;
+    }
+
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0)
+        return {};
+
+    return fd;
+}
+
+std::string key_for(mir::input::Keymap const& names)
+{
+    return names.model + '\0' + names.layout + '\0' + names.variant + '\0' + names.options;
+}
+}
+
+mf::CompiledKeymap::CompiledKeymap(xkb_keymap* keymap, std::string text) :
+    keymap_{keymap},
+    text{std::move(text)},
+    sealed_fd{sealed_copy_of(this->text)}
+{
+}
+
+mf::CompiledKeymap::~CompiledKeymap()
+{
+    xkb_keymap_unref(keymap_);
+}
+
+xkb_keymap* mf::CompiledKeymap::keymap() const
+{
+    return keymap_;
+}
+
+size_t mf::CompiledKeymap::size() const
+{
+    return text.size();
+}
+
+mir::Fd mf::CompiledKeymap::client_fd() const
+{
+    if (sealed_fd >= 0)
+        return sealed_fd;
+
+    // Without seals one client could rewrite the keymap under the others
+    mir::AnonymousShmFile shm_buffer{text.size()};
+    memcpy(shm_buffer.base_ptr(), text.data(), text.size());
+    return Fd{dup(shm_buffer.fd())};
+}
+
+mf::KeymapCache::KeymapCache() :
+    context{xkb_context_new(XKB_CONTEXT_NO_FLAGS), &xkb_context_unref}
+{
+}
+
+mf::KeymapCache::~KeymapCache() = default;
+
+auto mf::KeymapCache::from_names(input::Keymap const& names) -> std::shared_ptr<CompiledKeymap const>
+{
+    auto const key = key_for(names);
+
+    std::lock_guard<decltype(mutex)> lock{mutex};
+
+    auto const existing = by_names.find(key);
+    if (existing != by_names.end())
+        return existing->second;
+
+    xkb_rule_names const rule_names = {
+        "evdev",
+        names.model.c_str(),
+        names.layout.c_str(),
+        names.variant.c_str(),
+        names.options.c_str()
+    };
+
+    auto const keymap = xkb_keymap_new_from_names(context.get(), &rule_names, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    if (!keymap)
+        BOOST_THROW_EXCEPTION(std::runtime_error{"Failed to compile keymap"});
+
+    std::unique_ptr<char, void(*)(void*)> buffer{xkb_keymap_get_as_string(keymap, XKB_KEYMAP_FORMAT_TEXT_V1), free};
+
+    auto const result = std::make_shared<CompiledKeymap const>(keymap, std::string{buffer.get()});
+    insert(by_names, key, result);
+    return result;
+}
+
+auto mf::KeymapCache::from_buffer(char const* buffer, size_t length) -> std::shared_ptr<CompiledKeymap const>
+{
+    std::string key{buffer, length};
+
+    std::lock_guard<decltype(mutex)> lock{mutex};
+
+    auto const existing = by_buffer.find(key);
+    if (existing != by_buffer.end())
+        return existing->second;
+
+    auto const keymap = xkb_keymap_new_from_buffer(
+        context.get(),
+        buffer,
+        length,
+        XKB_KEYMAP_FORMAT_TEXT_V1,
+        XKB_KEYMAP_COMPILE_NO_FLAGS);
+    if (!keymap)
+        BOOST_THROW_EXCEPTION(std::runtime_error{"Failed to compile keymap"});
+
+    // Clients get the buffer exactly as it was sent to us
+    auto const result = std::make_shared<CompiledKeymap const>(keymap, key);
+    insert(by_buffer, key, result);
+    return result;
+}
+
+void mf::KeymapCache::insert(
+    Entries& entries,
+    std::string const& key,
+    std::shared_ptr<CompiledKeymap const> const& keymap)
+{
+    if (entries.size() >= max_cached_keymaps)
+    {
+        for (auto i = entries.begin(); i != entries.end();)
+        {
+            if (i->second.use_count() == 1)
+                i = entries.erase(i);
+            else
+                ++i;
+        }
+    }
+
+    entries[key] = keymap;
+}
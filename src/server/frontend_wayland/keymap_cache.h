@@ -0,0 +1,100 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_KEYMAP_CACHE_H
+#define MIR_FRONTEND_KEYMAP_CACHE_H
+
+#include "mir/fd.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// from <xkbcommon/xkbcommon.h>
+struct xkb_keymap;
+struct xkb_context;
+
+namespace mir
+{
+namespace input
+{
+struct Keymap;
+}
+
+namespace frontend
+{
+/// A compiled xkb keymap along with the text sent to clients
+class CompiledKeymap
+{
+public:
+    CompiledKeymap(xkb_keymap* keymap, std::string text);
+    ~CompiledKeymap();
+
+    xkb_keymap* keymap() const;
+
+    /// Size of the keymap text, as sent in wl_keyboard.keymap
+    size_t size() const;
+
+    /**
+     * An fd holding the keymap text for a client.
+     *
+     * Where the kernel supports sealing this is one read-only memfd shared by
+     * every client; otherwise each call makes a private copy.
+     */
+    Fd client_fd() const;
+
+private:
+    CompiledKeymap(CompiledKeymap const&) = delete;
+    CompiledKeymap& operator=(CompiledKeymap const&) = delete;
+
+    xkb_keymap* const keymap_;
+    std::string const text;
+    Fd const sealed_fd;
+};
+
+/**
+ * Compiles each distinct keymap once and shares the result between keyboards.
+ *
+ * Compiling a keymap takes tens of milliseconds, and previously happened for
+ * every wl_keyboard a client created.
+ */
+class KeymapCache
+{
+public:
+    KeymapCache();
+    ~KeymapCache();
+
+    std::shared_ptr<CompiledKeymap const> from_names(input::Keymap const& names);
+    std::shared_ptr<CompiledKeymap const> from_buffer(char const* buffer, size_t length);
+
+private:
+    KeymapCache(KeymapCache const&) = delete;
+    KeymapCache& operator=(KeymapCache const&) = delete;
+
+    using Entries = std::unordered_map<std::string, std::shared_ptr<CompiledKeymap const>>;
+
+    void insert(Entries& entries, std::string const& key, std::shared_ptr<CompiledKeymap const> const& keymap);
+
+    std::mutex mutex;
+    std::unique_ptr<xkb_context, void (*)(xkb_context*)> const context;
+    Entries by_names;
+    Entries by_buffer;
+};
+}
+}
+
+#endif // MIR_FRONTEND_KEYMAP_CACHE_H
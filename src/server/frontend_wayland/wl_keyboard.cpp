@@ -20,10 +20,10 @@
 
 #include "wayland_utils.h"
 #include "wl_surface.h"
+#include "keymap_cache.h"
 
 #include "mir/executor.h"
 #include "mir/client/event.h"
-#include "mir/anonymous_shm_file.h"
 #include "mir/input/keymap.h"
 
 #include <xkbcommon/xkbcommon.h>
@@ -38,12 +38,12 @@ mf::WlKeyboard::WlKeyboard(
     wl_resource* parent,
     uint32_t id,
     mir::input::Keymap const& initial_keymap,
+    std::shared_ptr<KeymapCache> const& keymap_cache,
     std::function<void(WlKeyboard*)> const& on_destroy,
     std::function<std::vector<uint32_t>()> const& acquire_current_keyboard_state)
     : Keyboard(client, parent, id),
-      keymap{nullptr, &xkb_keymap_unref},
+      keymap_cache{keymap_cache},
       state{nullptr, &xkb_state_unref},
-      context{xkb_context_new(XKB_CONTEXT_NO_FLAGS), &xkb_context_unref},
       on_destroy{on_destroy},
       acquire_current_keyboard_state{acquire_current_keyboard_state}
 {
@@ -136,7 +136,7 @@ void mf::WlKeyboard::handle_window_event(MirWindowEvent const* event, WlSurface*
             }
 
             // Rebuild xkb state
-            state = decltype(state)(xkb_state_new(keymap.get()), &xkb_state_unref);
+            state = decltype(state)(xkb_state_new(keymap->keymap()), &xkb_state_unref);
             for (auto scancode : keyboard_state)
             {
                 xkb_state_update_key(state.get(), scancode + 8, XKB_KEY_DOWN);
@@ -160,52 +160,25 @@ void mf::WlKeyboard::handle_keymap_event(MirKeymapEvent const* event, WlSurface*
 
     mir_keymap_event_get_keymap_buffer(event, &buffer, &length);
 
-    mir::AnonymousShmFile shm_buffer{length};
-    memcpy(shm_buffer.base_ptr(), buffer, length);
+    keymap = keymap_cache->from_buffer(buffer, length);
+    state = decltype(state)(xkb_state_new(keymap->keymap()), &xkb_state_unref);
 
-    send_keymap_event(KeymapFormat::xkb_v1,
-                      Fd{IntOwnedFd{shm_buffer.fd()}},
-                      length);
-
-    keymap = decltype(keymap)(xkb_keymap_new_from_buffer(
-        context.get(),
-        buffer,
-        length,
-        XKB_KEYMAP_FORMAT_TEXT_V1,
-        XKB_KEYMAP_COMPILE_NO_FLAGS),
-        &xkb_keymap_unref);
-
-    state = decltype(state)(xkb_state_new(keymap.get()), &xkb_state_unref);
+    send_keymap();
 }
 
 void mf::WlKeyboard::set_keymap(mir::input::Keymap const& new_keymap)
 {
-    xkb_rule_names const names = {
-        "evdev",
-        new_keymap.model.c_str(),
-        new_keymap.layout.c_str(),
-        new_keymap.variant.c_str(),
-        new_keymap.options.c_str()
-    };
-    keymap = decltype(keymap){
-        xkb_keymap_new_from_names(
-            context.get(),
-            &names,
-            XKB_KEYMAP_COMPILE_NO_FLAGS),
-        &xkb_keymap_unref};
+    keymap = keymap_cache->from_names(new_keymap);
 
     // TODO: We might need to copy across the existing depressed keys?
-    state = decltype(state)(xkb_state_new(keymap.get()), &xkb_state_unref);
-
-    std::unique_ptr<char, void(*)(void*)> buffer{xkb_keymap_get_as_string(keymap.get(), XKB_KEYMAP_FORMAT_TEXT_V1), free};
-    auto length = strlen(buffer.get());
+    state = decltype(state)(xkb_state_new(keymap->keymap()), &xkb_state_unref);
 
-    mir::AnonymousShmFile shm_buffer{length};
-    memcpy(shm_buffer.base_ptr(), buffer.get(), length);
+    send_keymap();
+}
 
-    send_keymap_event(KeymapFormat::xkb_v1,
-                      Fd{IntOwnedFd{shm_buffer.fd()}},
-                      length);
+void mf::WlKeyboard::send_keymap()
+{
+    send_keymap_event(KeymapFormat::xkb_v1, keymap->client_fd(), keymap->size());
 }
 
 void mf::WlKeyboard::update_modifier_state()
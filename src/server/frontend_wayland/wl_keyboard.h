@@ -21,13 +21,12 @@
 
 #include "generated/wayland_wrapper.h"
 
+#include <memory>
 #include <vector>
 #include <functional>
 
 // from <xkbcommon/xkbcommon.h>
-struct xkb_keymap;
 struct xkb_state;
-struct xkb_context;
 
 // from "mir_toolkit/events/event.h"
 struct MirKeyboardEvent;
@@ -48,6 +47,8 @@ class Keymap;
 namespace frontend
 {
 class WlSurface;
+class KeymapCache;
+class CompiledKeymap;
 
 class WlKeyboard : public wayland::Keyboard
 {
@@ -57,6 +58,7 @@ public:
         wl_resource* parent,
         uint32_t id,
         mir::input::Keymap const& initial_keymap,
+        std::shared_ptr<KeymapCache> const& keymap_cache,
         std::function<void(WlKeyboard*)> const& on_destroy,
         std::function<std::vector<uint32_t>()> const& acquire_current_keyboard_state);
 
@@ -70,9 +72,11 @@ public:
 private:
     void update_modifier_state();
 
-    std::unique_ptr<xkb_keymap, void (*)(xkb_keymap *)> keymap;
+    void send_keymap();
+
+    std::shared_ptr<KeymapCache> const keymap_cache;
+    std::shared_ptr<CompiledKeymap const> keymap;
     std::unique_ptr<xkb_state, void (*)(xkb_state *)> state;
-    std::unique_ptr<xkb_context, void (*)(xkb_context *)> const context;
 
     std::function<void(WlKeyboard*)> on_destroy;
     std::function<std::vector<uint32_t>()> const acquire_current_keyboard_state;
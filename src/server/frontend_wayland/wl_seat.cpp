@@ -25,6 +25,7 @@
 #include "wl_keyboard.h"
 #include "wl_pointer.h"
 #include "wl_touch.h"
+#include "keymap_cache.h"
 
 #include "mir/executor.h"
 #include "mir/client/event.h"
@@ -146,6 +147,7 @@ mf::WlSeat::WlSeat(
     std::shared_ptr<mir::Executor> const& executor)
     :   Seat(display, 5),
         keymap{std::make_unique<input::Keymap>()},
+        keymap_cache{std::make_shared<KeymapCache>()},
         config_observer{
             std::make_shared<ConfigObserver>(
                 *keymap,
@@ -231,6 +233,7 @@ void mf::WlSeat::get_keyboard(wl_client* client, wl_resource* resource, uint32_t
             resource,
             id,
             *keymap,
+            keymap_cache,
             [listeners = keyboard_listeners, client](WlKeyboard* listener)
             {
                 listeners->unregister_listener(client, listener);
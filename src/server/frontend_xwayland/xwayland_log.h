@@ -23,15 +23,20 @@
 
 namespace mir
 {
+inline bool verbose_log_enabled()
+{
+    static bool const enabled{getenv("MIR_X11_VERBOSE_LOG") != nullptr};
+    return enabled;
+}
 inline void log_verbose(std::string const& message)
 {
-    if (getenv("MIR_X11_VERBOSE_LOG"))
+    if (verbose_log_enabled())
         log_info(message);
 }
 template <typename... Args>
 void log_verbose(char const* fmt, Args&&... args)
 {
-    if (getenv("MIR_X11_VERBOSE_LOG"))
+    if (verbose_log_enabled())
         log_info(fmt, std::forward<Args>(args)...);
 }
 } /* mir */
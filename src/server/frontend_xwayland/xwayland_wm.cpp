@@ -347,7 +347,11 @@ void mf::XWaylandWM::handle_property_notify(xcb_property_notify_event_t *event)
     if (!surface)
         return;
 
-    surface->dirty_properties();
+    surface->dirty_property(event->atom);
+
+    // Reading the property back is only for diagnostics, don't pay for the round trip otherwise
+    if (!mir::verbose_log_enabled())
+        return;
 
     if (event->state == XCB_PROPERTY_DELETE)
         mir::log_verbose("XCB_PROPERTY_NOTIFY: deleted");
@@ -396,7 +400,6 @@ void mf::XWaylandWM::handle_map_request(xcb_map_request_event_t *event)
     surface->set_net_wm_state();
     surface->set_workspace(0);
     xcb_map_window(xcb_connection, event->window);
-    xcb_flush(xcb_connection);
 }
 
 void mf::XWaylandWM::handle_unmap_notify(xcb_unmap_notify_event_t *event)
@@ -421,7 +424,6 @@ void mf::XWaylandWM::handle_unmap_notify(xcb_unmap_notify_event_t *event)
     surface->set_wm_state(XWaylandWMSurface::WithdrawnState);
     surface->set_workspace(-1);
     xcb_unmap_window(xcb_connection, event->window);
-    xcb_flush(xcb_connection);
 }
 
 void mf::XWaylandWM::handle_client_message(xcb_client_message_event_t *event)
@@ -546,10 +548,7 @@ void mf::XWaylandWM::handle_configure_request(xcb_configure_request_event_t *eve
         values[++i] = event->stack_mode;
 
     if (i >= 0)
-    {
         xcb_configure_window(xcb_connection, event->window, event->value_mask, values);
-        xcb_flush(xcb_connection);
-    }
 }
 
 // Cursor
@@ -715,6 +714,9 @@ void mf::XWaylandWM::wm_get_resources()
     for (i = 0; i < ARRAY_LENGTH(atoms); i++)
         cookies[i] = xcb_intern_atom(xcb_connection, 0, strlen(atoms[i].name), atoms[i].name);
 
+    // Send every request before waiting on any reply, so they all share one round trip
+    xfixes_cookie = xcb_xfixes_query_version(xcb_connection, XCB_XFIXES_MAJOR_VERSION, XCB_XFIXES_MINOR_VERSION);
+
     for (i = 0; i < ARRAY_LENGTH(atoms); i++)
     {
         reply = xcb_intern_atom_reply(xcb_connection, cookies[i], NULL);
@@ -726,7 +728,6 @@ void mf::XWaylandWM::wm_get_resources()
     if (!xfixes || !xfixes->present)
         mir::log_warning("xfixes not available");
 
-    xfixes_cookie = xcb_xfixes_query_version(xcb_connection, XCB_XFIXES_MAJOR_VERSION, XCB_XFIXES_MINOR_VERSION);
     xfixes_reply = xcb_xfixes_query_version_reply(xcb_connection, xfixes_cookie, NULL);
 
     mir::log_verbose("xfixes version: %d.%d", xfixes_reply->major_version, xfixes_reply->minor_version);
@@ -773,6 +774,9 @@ void mf::XWaylandWM::dump_property(xcb_atom_t property, xcb_get_property_reply_t
     int len;
     uint32_t i;
 
+    if (!mir::verbose_log_enabled())
+        return;
+
     mir::log_verbose("prop name %s: ", get_atom_name(property));
     if (reply == NULL)
     {
@@ -803,6 +807,7 @@ void mf::XWaylandWM::dump_property(xcb_atom_t property, xcb_get_property_reply_t
     else if (reply->type == XCB_ATOM_ATOM)
     {
         atom_value = (xcb_atom_t *)xcb_get_property_value(reply);
+        cache_atom_names(atom_value, reply->value_len);
         for (i = 0; i < reply->value_len; i++)
         {
             name = get_atom_name(atom_value[i]);
@@ -814,29 +819,45 @@ void mf::XWaylandWM::dump_property(xcb_atom_t property, xcb_get_property_reply_t
 
 const char *mf::XWaylandWM::get_atom_name(xcb_atom_t atom)
 {
-    xcb_get_atom_name_cookie_t cookie;
-    xcb_get_atom_name_reply_t *reply;
-    xcb_generic_error_t *e;
-    static char buffer[64];
-
     if (atom == XCB_ATOM_NONE)
         return "None";
 
-    cookie = xcb_get_atom_name(xcb_connection, atom);
-    reply = xcb_get_atom_name_reply(xcb_connection, cookie, &e);
+    cache_atom_names(&atom, 1);
+
+    return atom_names[atom].c_str();
+}
+
+void mf::XWaylandWM::cache_atom_names(xcb_atom_t const* atoms, uint32_t count)
+{
+    // Atoms live as long as the X server, so each name only needs fetching once. Send all
+    // the requests before waiting on any reply so a batch costs a single round trip.
+    std::vector<std::pair<xcb_atom_t, xcb_get_atom_name_cookie_t>> cookies;
 
-    if (reply)
+    for (uint32_t i = 0; i < count; i++)
     {
-        snprintf(buffer, sizeof buffer, "%.*s", xcb_get_atom_name_name_length(reply), xcb_get_atom_name_name(reply));
+        if (atoms[i] != XCB_ATOM_NONE && atom_names.find(atoms[i]) == atom_names.end())
+        {
+            atom_names[atoms[i]];
+            cookies.emplace_back(atoms[i], xcb_get_atom_name(xcb_connection, atoms[i]));
+        }
     }
-    else
+
+    for (auto const& cookie : cookies)
     {
-        snprintf(buffer, sizeof buffer, "(atom %u)", atom);
-    }
+        auto const reply = xcb_get_atom_name_reply(xcb_connection, cookie.second, nullptr);
 
-    free(reply);
+        if (reply)
+        {
+            atom_names[cookie.first] =
+                std::string{xcb_get_atom_name_name(reply), size_t(xcb_get_atom_name_name_length(reply))};
+        }
+        else
+        {
+            atom_names[cookie.first] = "(atom " + std::to_string(cookie.first) + ")";
+        }
 
-    return buffer;
+        free(reply);
+    }
 }
 
 void mf::XWaylandWM::setup_visual_and_colormap()
@@ -19,7 +19,9 @@
 #define MIR_FRONTEND_XWAYLAND_WM_H
 
 #include <map>
+#include <string>
 #include <thread>
+#include <vector>
 #include <wayland-server-core.h>
 
 #include "mir/dispatch/threaded_dispatcher.h"
@@ -161,6 +163,7 @@ private:
     void wm_get_resources();
     void read_and_dump_property(xcb_window_t window, xcb_atom_t property);
     const char *get_atom_name(xcb_atom_t atom);
+    void cache_atom_names(xcb_atom_t const* atoms, uint32_t count);
     bool is_ours(uint32_t id);
     void setup_visual_and_colormap();
 
@@ -193,6 +196,7 @@ private:
     xcb_screen_t *xcb_screen;
     xcb_window_t xcb_window;
     std::map<xcb_window_t, std::shared_ptr<XWaylandWMSurface>> surfaces;
+    std::map<xcb_atom_t, std::string> atom_names;
     std::shared_ptr<dispatch::ReadableFd> wm_dispatcher;
     int xcb_cursor;
     std::vector<xcb_cursor_t> xcb_cursors;
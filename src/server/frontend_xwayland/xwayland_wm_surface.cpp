@@ -33,7 +33,7 @@
 namespace mf = mir::frontend;
 
 mf::XWaylandWMSurface::XWaylandWMSurface(XWaylandWM *wm, xcb_window_t window)
-    : xwm(wm), window(window), props_dirty(true)
+    : xwm(wm), window(window)
 {
     uint32_t values[1];
     xcb_get_geometry_cookie_t geometry_cookie;
@@ -54,9 +54,9 @@ mf::XWaylandWMSurface::~XWaylandWMSurface()
     destroyed = true;
 }
 
-void mf::XWaylandWMSurface::dirty_properties()
+void mf::XWaylandWMSurface::dirty_property(xcb_atom_t property)
 {
-    props_dirty = true;
+    property_cache.erase(property);
 }
 
 void mf::XWaylandWMSurface::set_surface_id(uint32_t id)
@@ -76,7 +76,6 @@ void mf::XWaylandWMSurface::set_surface(WlSurface *wls)
       shell_surface->set_title(properties.title);
 
     shell_surface->set_toplevel();
-    xcb_flush(xwm->get_xcb_connection());
 }
 
 void mf::XWaylandWMSurface::set_workspace(int workspace)
@@ -91,7 +90,6 @@ void mf::XWaylandWMSurface::set_workspace(int workspace)
     {
         xcb_delete_property(xwm->get_xcb_connection(), window, xwm->xcb_atom.net_wm_desktop);
     }
-    xcb_flush(xwm->get_xcb_connection());
 }
 
 void mf::XWaylandWMSurface::set_wm_state(WmState state)
@@ -102,7 +100,6 @@ void mf::XWaylandWMSurface::set_wm_state(WmState state)
 
     xcb_change_property(xwm->get_xcb_connection(), XCB_PROP_MODE_REPLACE, window, xwm->xcb_atom.wm_state,
                         xwm->xcb_atom.wm_state, 32, 2, property);
-    xcb_flush(xwm->get_xcb_connection());
 }
 
 void mf::XWaylandWMSurface::set_net_wm_state()
@@ -120,15 +117,10 @@ void mf::XWaylandWMSurface::set_net_wm_state()
 
     xcb_change_property(xwm->get_xcb_connection(), XCB_PROP_MODE_REPLACE, window, xwm->xcb_atom.net_wm_state,
                         XCB_ATOM_ATOM, 32, i, property);
-    xcb_flush(xwm->get_xcb_connection());
 }
 
 void mf::XWaylandWMSurface::read_properties()
 {
-    if (!props_dirty)
-        return;
-    props_dirty = false;
-
     std::map<xcb_atom_t, xcb_atom_t> props;
     props[XCB_ATOM_WM_CLASS] = XCB_ATOM_STRING;
     props[XCB_ATOM_WM_NAME] = XCB_ATOM_STRING;
@@ -140,14 +132,28 @@ void mf::XWaylandWMSurface::read_properties()
     props[xwm->xcb_atom.net_wm_name] = XCB_ATOM_STRING;
     props[xwm->xcb_atom.motif_wm_hints] = TYPE_MOTIF_WM_HINTS;
 
+    // Only read the properties that changed, and send all the requests before
+    // waiting on any reply so they cost a single round trip
     std::map<xcb_atom_t, xcb_get_property_cookie_t> cookies;
     for (const auto &atom : props)
     {
+        if (property_cache.find(atom.first) != property_cache.end())
+            continue;
+
         xcb_get_property_cookie_t cookie =
             xcb_get_property(xwm->get_xcb_connection(), 0, window, atom.first, XCB_ATOM_ANY, 0, 2048);
         cookies[atom.first] = cookie;
     }
 
+    if (cookies.empty())
+        return;
+
+    for (const auto &cookie : cookies)
+    {
+        if (auto reply = xcb_get_property_reply(xwm->get_xcb_connection(), cookie.second, nullptr))
+            property_cache[cookie.first] = std::shared_ptr<xcb_get_property_reply_t>{reply, &free};
+    }
+
     properties.deleteWindow = 0;
 
     if (overrideRedirect)
@@ -160,17 +166,18 @@ void mf::XWaylandWMSurface::read_properties()
     for (const auto &atom_ptr : props)
     {
         xcb_atom_t atom = atom_ptr.first;
-        xcb_get_property_reply_t *reply = xcb_get_property_reply(xwm->get_xcb_connection(), cookies[atom], nullptr);
-        if (!reply)
+        auto const cached = property_cache.find(atom);
+        if (cached == property_cache.end())
         {
             mir::log_verbose("read_properties: Bad window, usually");
             continue;
         }
 
+        xcb_get_property_reply_t *reply = cached->second.get();
+
         if (reply->type == XCB_ATOM_NONE)
         {
             mir::log_verbose("read_properties: No such info");
-            free(reply);
             continue;
         }
 
@@ -247,8 +254,6 @@ void mf::XWaylandWMSurface::read_properties()
         default:
             break;
         }
-
-        free(reply);
     }
 }
 
@@ -25,6 +25,9 @@ extern "C" {
 #include <xcb/xcb.h>
 }
 
+#include <map>
+#include <memory>
+
 struct wm_size_hints
 {
     uint32_t flags;
@@ -129,7 +132,7 @@ public:
 
     XWaylandWMSurface(XWaylandWM *wm, xcb_window_t window);
     ~XWaylandWMSurface();
-    void dirty_properties();
+    void dirty_property(xcb_atom_t property);
     void read_properties();
     void set_surface_id(uint32_t surface_id);
     void set_surface(WlSurface *wls);
@@ -153,7 +156,9 @@ private:
     xcb_window_t window;
     WlSurface *wlsurface;
     std::shared_ptr<XWaylandWMShellSurface> shell_surface;
-    bool props_dirty;
+    // Replies to the property reads read_properties() makes, kept until a
+    // PropertyNotify says the property changed
+    std::map<xcb_atom_t, std::shared_ptr<xcb_get_property_reply_t>> property_cache;
     uint32_t surface_id;
     bool maximized;
     bool fullscreen;
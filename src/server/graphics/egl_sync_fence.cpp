@@ -0,0 +1,85 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/graphics/egl_sync_fence.h"
+#include "mir/graphics/gl_extensions_base.h"
+
+#include MIR_SERVER_GL_H
+
+namespace mg = mir::graphics;
+
+mg::EGLSyncFence::EGLSyncFence() :
+    eglCreateSyncKHR{nullptr},
+    eglDestroySyncKHR{nullptr},
+    eglClientWaitSyncKHR{nullptr},
+    support{Support::unknown},
+    display{EGL_NO_DISPLAY},
+    sync{EGL_NO_SYNC_KHR}
+{
+}
+
+mg::EGLSyncFence::~EGLSyncFence() noexcept
+{
+    reset();
+}
+
+void mg::EGLSyncFence::raise()
+{
+    reset();
+
+    if (support == Support::unknown)
+    {
+        display = eglGetCurrentDisplay();
+        auto const extensions = display != EGL_NO_DISPLAY ? eglQueryString(display, EGL_EXTENSIONS) : nullptr;
+        if (extensions && mg::GLExtensionsBase{extensions}.support("EGL_KHR_fence_sync"))
+        {
+            eglCreateSyncKHR =
+                reinterpret_cast<PFNEGLCREATESYNCKHRPROC>(eglGetProcAddress("eglCreateSyncKHR"));
+            eglDestroySyncKHR =
+                reinterpret_cast<PFNEGLDESTROYSYNCKHRPROC>(eglGetProcAddress("eglDestroySyncKHR"));
+            eglClientWaitSyncKHR =
+                reinterpret_cast<PFNEGLCLIENTWAITSYNCKHRPROC>(eglGetProcAddress("eglClientWaitSyncKHR"));
+        }
+        support = eglCreateSyncKHR && eglDestroySyncKHR && eglClientWaitSyncKHR ?
+            Support::supported : Support::unsupported;
+    }
+
+    if (support == Support::supported)
+        sync = eglCreateSyncKHR(display, EGL_SYNC_FENCE_KHR, nullptr);
+
+    if (sync != EGL_NO_SYNC_KHR)
+        glFlush();
+    else
+        glFinish();
+}
+
+void mg::EGLSyncFence::wait()
+{
+    if (sync != EGL_NO_SYNC_KHR)
+    {
+        eglClientWaitSyncKHR(display, sync, 0, EGL_FOREVER_KHR);
+        reset();
+    }
+}
+
+void mg::EGLSyncFence::reset()
+{
+    if (sync != EGL_NO_SYNC_KHR)
+    {
+        eglDestroySyncKHR(display, sync);
+        sync = EGL_NO_SYNC_KHR;
+    }
+}
@@ -124,6 +124,9 @@ bool mgn::detail::DisplayBuffer::overlay(RenderableList const& list)
         return false;
     }
 
+    //only the topmost renderable is passed through. Passing several would need a
+    //host chain each, and the host can't update a surface spec and several chains
+    //atomically, so it could present a frame mixing old and new layers.
     auto const topmost = list.back();
 
     if ((topmost->screen_position() != area) ||
@@ -147,7 +147,12 @@ void mgo::DisplayBuffer::release_current()
 
 void mgo::DisplayBuffer::swap_buffers()
 {
-    glFinish();
+    // Throttle to one frame in flight instead of draining the GPU every frame
+    auto& this_frame = frame_fences[next_fence];
+    next_fence = (next_fence + 1) % frame_fences.size();
+
+    this_frame.raise();
+    frame_fences[next_fence].wait();
 }
 
 bool mgo::DisplayBuffer::overlay(RenderableList const&)
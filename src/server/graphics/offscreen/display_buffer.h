@@ -20,6 +20,7 @@
 #define MIR_GRAPHICS_OFFSCREEN_DISPLAY_BUFFER_H_
 
 #include "mir/graphics/surfaceless_egl_context.h"
+#include "mir/graphics/egl_sync_fence.h"
 
 #include "mir/graphics/display_buffer.h"
 #include "mir/geometry/size.h"
@@ -28,6 +29,8 @@
 
 #include <EGL/egl.h>
 
+#include <array>
+
 namespace mir
 {
 namespace graphics
@@ -77,6 +80,8 @@ private:
     SurfacelessEGLContext const egl_context;
     detail::GLFramebufferObject const fbo;
     geometry::Rectangle const area;
+    std::array<EGLSyncFence, 2> frame_fences;
+    size_t next_fence{0};
 };
 
 }
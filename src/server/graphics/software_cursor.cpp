@@ -217,14 +217,25 @@ void mg::SoftwareCursor::hide()
 
 void mg::SoftwareCursor::move_to(geometry::Point position)
 {
+    geom::Rectangle old_area;
+    geom::Rectangle new_area;
     {
         std::lock_guard<std::mutex> lg{guard};
 
         if (!renderable)
             return;
 
+        old_area = renderable->screen_position();
         renderable->move_to(position - hotspot);
+        new_area = renderable->screen_position();
+
+        // A hidden cursor isn't in the scene, so moving it damages nothing
+        if (!visible)
+            return;
     }
 
-    scene->emit_scene_changed();
+    // Only the outputs the cursor has left or entered need recompositing
+    scene->emit_scene_damaged(old_area);
+    if (new_area != old_area)
+        scene->emit_scene_damaged(new_area);
 }
@@ -150,6 +150,10 @@ struct UpdateCursorOnSceneChanges : ms::Observer
         cursor_controller->update_cursor_image();
     }
 
+    void scene_damaged(geom::Rectangle const&) override
+    {
+    }
+
     void surface_exists(ms::Surface *surface)
     {
         add_surface_observer(surface);
@@ -143,7 +143,7 @@ mir::DefaultServerConfiguration::the_input_dispatcher()
                 !options->is_set(options::host_socket_opt);
 
             return std::make_shared<mi::KeyRepeatDispatcher>(
-                the_event_filter_chain_dispatcher(), the_main_loop(), the_cookie_authority(),
+                the_event_filter_chain_dispatcher(), the_main_loop(), the_clock(), the_cookie_authority(),
                 enable_repeat, key_repeat_timeout, key_repeat_delay, false);
         });
 }
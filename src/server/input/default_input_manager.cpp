@@ -20,6 +20,7 @@
 
 #include "mir/input/platform.h"
 #include "mir/dispatch/action_queue.h"
+#include "mir/dispatch/batching_dispatchable.h"
 #include "mir/dispatch/multiplexing_dispatchable.h"
 #include "mir/dispatch/threaded_dispatcher.h"
 
@@ -86,9 +87,11 @@ void mi::DefaultInputManager::start()
                         promise->set_value();
                    });
 
+    // Every input device has its own fd, so drain the ready ones together
+    std::size_t const max_batch{16};
     input_thread = std::make_unique<dispatch::ThreadedDispatcher>(
         "Mir/Input Reader",
-        multiplexer,
+        std::make_shared<dispatch::BatchingDispatchable>(multiplexer, max_batch),
         [this]()
         {
             stop_platforms();
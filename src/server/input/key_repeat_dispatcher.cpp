@@ -22,7 +22,9 @@
 #include "mir/input/input_device_hub.h"
 #include "mir/time/alarm_factory.h"
 #include "mir/time/alarm.h"
+#include "mir/time/clock.h"
 #include "mir/events/event_builders.h"
+#include "mir/events/input_event.h"
 #include "mir/cookie/authority.h"
 
 #include <boost/throw_exception.hpp>
@@ -70,6 +72,7 @@ struct DeviceRemovalFilter : mi::InputDeviceObserver
 mi::KeyRepeatDispatcher::KeyRepeatDispatcher(
     std::shared_ptr<mi::InputDispatcher> const& next_dispatcher,
     std::shared_ptr<mir::time::AlarmFactory> const& factory,
+    std::shared_ptr<mir::time::Clock> const& clock,
     std::shared_ptr<mir::cookie::Authority> const& cookie_authority,
     bool repeat_enabled,
     std::chrono::milliseconds repeat_timeout,
@@ -77,6 +80,7 @@ mi::KeyRepeatDispatcher::KeyRepeatDispatcher(
     bool disable_repeat_on_touchscreen)
     : next_dispatcher(next_dispatcher),
       alarm_factory(factory),
+      clock(clock),
       cookie_authority(cookie_authority),
       repeat_enabled(repeat_enabled),
       repeat_timeout(repeat_timeout),
@@ -99,7 +103,17 @@ void mi::KeyRepeatDispatcher::set_touch_button_device(MirInputDeviceId id)
 void mi::KeyRepeatDispatcher::remove_device(MirInputDeviceId id)
 {
     std::lock_guard<std::mutex> lock(repeat_state_mutex);
-    repeat_state_by_device.erase(id); // destructor cancels alarms
+
+    auto const device_state = repeat_state_by_device.find(id);
+    if (device_state != repeat_state_by_device.end())
+    {
+        for (auto const& repeat : device_state->second.repeats_by_scancode)
+            schedule.erase(repeat.second);
+
+        repeat_state_by_device.erase(device_state);
+        schedule_alarm_locked();
+    }
+
     if (touch_button_device.is_set() && touch_button_device.value() == id)
         touch_button_device.consume();
 }
@@ -146,51 +160,41 @@ bool mi::KeyRepeatDispatcher::handle_key_input(MirInputDeviceId id, MirKeyboardE
     {
     case mir_keyboard_action_up:
     {
-        auto it = device_state.repeat_alarms_by_scancode.find(scan_code);
-        if (it == device_state.repeat_alarms_by_scancode.end())
+        auto it = device_state.repeats_by_scancode.find(scan_code);
+        if (it == device_state.repeats_by_scancode.end())
         {
             return false;
         }
-        device_state.repeat_alarms_by_scancode.erase(it);
+        schedule.erase(it->second);
+        device_state.repeats_by_scancode.erase(it);
+        schedule_alarm_locked();
         break;
     }
     case mir_keyboard_action_down:
     {
-        auto clone_event = [scan_code, id, this,
-             key_code = mir_keyboard_event_key_code(kev),
-             modifiers = mir_keyboard_event_modifiers(kev)]()
-             {
-                 auto const now = std::chrono::steady_clock::now().time_since_epoch();
-                 auto const cookie = cookie_authority->make_cookie(now.count());
-                 auto new_event = mev::make_event(
-                     id,
-                     now,
-                     cookie->serialize(),
-                     mir_keyboard_action_repeat,
-                     key_code,
-                     scan_code,
-                     modifiers);
-                 next_dispatcher->dispatch(std::move(new_event));
-             };
-
-        auto it = device_state.repeat_alarms_by_scancode.find(scan_code);
-        if (it != device_state.repeat_alarms_by_scancode.end())
+        auto it = device_state.repeats_by_scancode.find(scan_code);
+        if (it != device_state.repeats_by_scancode.end())
         {
             // When we receive a duplicated down we just replace the action
-            clone_event();
+            send_repeat_locked(it->second->second);
             return true;
         }
-        auto& capture_alarm = device_state.repeat_alarms_by_scancode[scan_code];
-        std::shared_ptr<mir::time::Alarm> alarm = alarm_factory->create_alarm(
-            [this, clone_event, &capture_alarm]() mutable
-            {
-                std::lock_guard<std::mutex> lg(repeat_state_mutex);
-                clone_event();
-
-                capture_alarm->reschedule_in(repeat_delay);
-            });
-        alarm->reschedule_in(repeat_timeout);
-        device_state.repeat_alarms_by_scancode[scan_code] = {alarm};
+
+        Repeat repeat{
+            id,
+            scan_code,
+            mev::make_event(
+                id,
+                std::chrono::nanoseconds{0},
+                std::vector<uint8_t>{},
+                mir_keyboard_action_repeat,
+                mir_keyboard_event_key_code(kev),
+                scan_code,
+                mir_keyboard_event_modifiers(kev))};
+
+        auto const first_repeat = clock->now() + repeat_timeout;
+        device_state.repeats_by_scancode[scan_code] = schedule.emplace(first_repeat, std::move(repeat));
+        schedule_alarm_locked();
     }
     case mir_keyboard_action_repeat:
         // Should we consume existing repeats?
@@ -201,6 +205,60 @@ bool mi::KeyRepeatDispatcher::handle_key_input(MirInputDeviceId id, MirKeyboardE
     return false;
 }
 
+void mi::KeyRepeatDispatcher::send_repeat_locked(Repeat const& repeat)
+{
+    auto const now = clock->now().time_since_epoch();
+    auto const cookie = cookie_authority->make_cookie(now.count());
+
+    auto new_event = mev::clone_event(*repeat.event);
+    new_event->to_input()->set_event_time(now);
+    new_event->to_input()->set_cookie(cookie->serialize());
+
+    next_dispatcher->dispatch(std::move(new_event));
+}
+
+void mi::KeyRepeatDispatcher::schedule_alarm_locked()
+{
+    if (schedule.empty())
+    {
+        if (repeat_alarm)
+            repeat_alarm->cancel();
+        return;
+    }
+
+    if (!repeat_alarm)
+        repeat_alarm = alarm_factory->create_alarm([this] { on_repeat_alarm(); });
+
+    repeat_alarm->reschedule_for(schedule.begin()->first);
+}
+
+void mi::KeyRepeatDispatcher::on_repeat_alarm()
+{
+    std::lock_guard<std::mutex> lg(repeat_state_mutex);
+
+    auto const now = clock->now();
+
+    while (!schedule.empty() && schedule.begin()->first <= now)
+    {
+        auto const due = schedule.begin();
+        send_repeat_locked(due->second);
+
+        // Repeat at fixed intervals from the first repeat, so a late alarm
+        // doesn't delay every following repeat. If we've fallen more than an
+        // interval behind, skip the missed repeats rather than bursting.
+        auto next_repeat = due->first + repeat_delay;
+        if (next_repeat <= now)
+            next_repeat = now + repeat_delay;
+
+        auto& device_state = repeat_state_by_device[due->second.device];
+        auto const scan_code = due->second.scan_code;
+        device_state.repeats_by_scancode[scan_code] = schedule.emplace(next_repeat, std::move(due->second));
+        schedule.erase(due);
+    }
+
+    schedule_alarm_locked();
+}
+
 void mi::KeyRepeatDispatcher::start()
 {
     next_dispatcher->start();
@@ -211,6 +269,8 @@ void mi::KeyRepeatDispatcher::stop()
     std::lock_guard<std::mutex> lg(repeat_state_mutex);
 
     repeat_state_by_device.clear();
+    schedule.clear();
+    schedule_alarm_locked();
 
     next_dispatcher->stop();
 }
@@ -22,9 +22,11 @@
 #include "mir/input/input_dispatcher.h"
 #include "mir/input/input_device_observer.h"
 #include "mir/optional_value.h"
+#include "mir/time/types.h"
 
 #include <memory>
 #include <chrono>
+#include <map>
 #include <mutex>
 #include <unordered_map>
 
@@ -38,6 +40,7 @@ namespace time
 {
 class AlarmFactory;
 class Alarm;
+class Clock;
 }
 namespace input
 {
@@ -47,6 +50,7 @@ class KeyRepeatDispatcher : public InputDispatcher
 public:
     KeyRepeatDispatcher(std::shared_ptr<InputDispatcher> const& next_dispatcher,
                         std::shared_ptr<time::AlarmFactory> const& factory,
+                        std::shared_ptr<time::Clock> const& clock,
                         std::shared_ptr<cookie::Authority> const& cookie_authority,
                         bool repeat_enabled,
                         std::chrono::milliseconds repeat_timeout, /* timeout before sending first repeat */
@@ -67,6 +71,7 @@ private:
 
     std::shared_ptr<InputDispatcher> const next_dispatcher;
     std::shared_ptr<time::AlarmFactory> const alarm_factory;
+    std::shared_ptr<time::Clock> const clock;
     std::shared_ptr<cookie::Authority> const cookie_authority;
     bool const repeat_enabled;
     std::chrono::milliseconds repeat_timeout;
@@ -74,14 +79,31 @@ private:
     bool const disable_repeat_on_touchscreen;
     optional_value<MirInputDeviceId> touch_button_device;
 
+    // A held key, with its repeat event built once when the key went down
+    struct Repeat
+    {
+        MirInputDeviceId device;
+        int scan_code;
+        std::shared_ptr<MirEvent const> event;
+    };
+
+    // Every held key on every device, ordered by when it next repeats. A
+    // single alarm is always scheduled for the earliest of them.
+    using Schedule = std::multimap<time::Timestamp, Repeat>;
+    Schedule schedule;
+    std::unique_ptr<time::Alarm> repeat_alarm;
+
     struct KeyboardState
     {
-        std::unordered_map<int, std::shared_ptr<mir::time::Alarm>> repeat_alarms_by_scancode;
+        std::unordered_map<int, Schedule::iterator> repeats_by_scancode;
     };
     std::unordered_map<MirInputDeviceId, KeyboardState> repeat_state_by_device;
     KeyboardState& ensure_state_for_device_locked(std::lock_guard<std::mutex> const&, MirInputDeviceId id);
 
     bool handle_key_input(MirInputDeviceId id, MirKeyboardEvent const* ev);
+    void send_repeat_locked(Repeat const& repeat);
+    void schedule_alarm_locked();
+    void on_repeat_alarm();
 };
 
 }
@@ -46,6 +46,9 @@
 #include "mir/graphics/display_configuration.h"
 #include "mir/frontend/display_changer.h"
 
+#include <algorithm>
+#include <thread>
+
 namespace mc = mir::compositor;
 namespace mf = mir::frontend;
 namespace mi = mir::input;
@@ -187,23 +190,29 @@ mir::DefaultServerConfiguration::the_session_coordinator()
         });
 }
 
+namespace
+{
+// Each snapshot worker needs its own pixel buffer (and so GL context)
+unsigned const max_snapshot_workers{4};
+
+std::shared_ptr<ms::PixelBuffer> make_gl_pixel_buffer(mg::Display& display)
+{
+    auto const ctx = dynamic_cast<mir::renderer::gl::ContextSource*>(display.native_display());
+    if (!ctx)
+        BOOST_THROW_EXCEPTION(std::logic_error("Display does not support GL rendering"));
+
+    return std::make_shared<ms::GLPixelBuffer>(ctx->create_gl_context());
+}
+}
+
 std::shared_ptr<ms::PixelBuffer>
 mir::DefaultServerConfiguration::the_pixel_buffer()
 {
     return pixel_buffer(
         [this]()
         {
-            auto as_context_source = [](mg::Display* display)
-            {
-                auto const ctx = dynamic_cast<renderer::gl::ContextSource*>(
-                        display->native_display());
-                if (!ctx)
-                    BOOST_THROW_EXCEPTION(std::logic_error("Display does not support GL rendering"));
-                return ctx;
-            };
-
-            return std::make_shared<ms::GLPixelBuffer>(
-                as_context_source(the_display().get())->create_gl_context());
+            default_pixel_buffer = true;
+            return make_gl_pixel_buffer(*the_display());
         });
 }
 
@@ -213,8 +222,28 @@ mir::DefaultServerConfiguration::the_snapshot_strategy()
     return snapshot_strategy(
         [this]()
         {
+            auto const workers = std::max(1u, std::min(std::thread::hardware_concurrency(), max_snapshot_workers));
+
+            // The factory runs on a snapshot thread, so resolve what it needs here
+            auto const first_pixel_buffer = the_pixel_buffer();
+            auto const display = the_display();
+
+            // Each further worker needs a pixel buffer of its own, which we can
+            // only make if the_pixel_buffer() hasn't been overridden
+            auto const further_workers = default_pixel_buffer ? workers - 1 : 0;
+
+            // Creating GL contexts is slow and most sessions never snapshot, so
+            // defer the further ones until the first snapshot is requested
             return std::make_shared<ms::ThreadedSnapshotStrategy>(
-                the_pixel_buffer());
+                [first_pixel_buffer, display, further_workers]
+                {
+                    std::vector<std::shared_ptr<ms::PixelBuffer>> pixel_buffers{first_pixel_buffer};
+
+                    for (auto i = 0u; i != further_workers; ++i)
+                        pixel_buffers.push_back(make_gl_pixel_buffer(*display));
+
+                    return pixel_buffers;
+                });
         });
 }
 
@@ -252,7 +281,7 @@ auto mir::DefaultServerConfiguration::the_application_not_responding_detector()
             using namespace std::literals::chrono_literals;
             return wrap_application_not_responding_detector(
                 std::make_shared<ms::TimeoutApplicationNotRespondingDetector>(
-                    *the_main_loop(), 1s));
+                    *the_main_loop(), the_clock(), 1s));
         });
 }
 
@@ -20,7 +20,7 @@
 
 #include <boost/throw_exception.hpp>
 
-#include <algorithm>
+#include <iterator>
 #include <stdexcept>
 
 namespace ms = mir::scene;
@@ -29,17 +29,21 @@ void ms::DefaultSessionContainer::insert_session(std::shared_ptr<Session> const&
 {
     std::unique_lock<std::mutex> lk(guard);
 
-    apps.push_back(session);
+    if (index.find(session.get()) != index.end())
+        BOOST_THROW_EXCEPTION(std::logic_error("Session already inserted"));
+
+    index[session.get()] = apps.insert(apps.end(), session);
 }
 
 void ms::DefaultSessionContainer::remove_session(std::shared_ptr<Session> const& session)
 {
     std::unique_lock<std::mutex> lk(guard);
 
-    auto it = std::find(apps.begin(), apps.end(), session);
-    if (it != apps.end())
+    auto it = index.find(session.get());
+    if (it != index.end())
     {
-        apps.erase(it);
+        apps.erase(it->second);
+        index.erase(it);
     }
     else
     {
@@ -51,7 +55,7 @@ void ms::DefaultSessionContainer::for_each(std::function<void(std::shared_ptr<Se
 {
     std::unique_lock<std::mutex> lk(guard);
 
-    for (auto const ptr : apps)
+    for (auto const& ptr : apps)
     {
         f(ptr);
     }
@@ -59,23 +63,19 @@ void ms::DefaultSessionContainer::for_each(std::function<void(std::shared_ptr<Se
 
 std::shared_ptr<ms::Session> ms::DefaultSessionContainer::successor_of(std::shared_ptr<Session> const& session) const
 {
-    std::shared_ptr<Session> result, first;
+    std::unique_lock<std::mutex> lk(guard);
 
     if (!session && apps.size())
         return apps.back();
     else if(!session)
         return std::shared_ptr<Session>();
 
-    for (auto it = apps.begin(); it != apps.end(); it++)
-    {
-        if (*it == session)
-        {
-            auto successor = ++it;
-            if (successor == apps.end())
-                return *apps.begin();
-            else return *successor;
-        }
-    }
+    auto it = index.find(session.get());
+    if (it == index.end())
+        BOOST_THROW_EXCEPTION(std::logic_error("Invalid session"));
 
-    BOOST_THROW_EXCEPTION(std::logic_error("Invalid session"));
+    auto successor = std::next(it->second);
+    if (successor == apps.end())
+        return apps.front();
+    else return *successor;
 }
@@ -19,9 +19,10 @@
 #ifndef MIR_SCENE_DEFAULT_SESSION_CONTAINER_H_
 #define MIR_SCENE_DEFAULT_SESSION_CONTAINER_H_
 
-#include <vector>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 
 #include "mir/scene/session_container.h"
 
@@ -39,7 +40,11 @@ public:
     std::shared_ptr<Session> successor_of(std::shared_ptr<Session> const& session) const override;
 
 private:
-    std::vector<std::shared_ptr<Session>> apps;
+    using Sessions = std::list<std::shared_ptr<Session>>;
+
+    // Sessions in insertion order, indexed so that lookups don't need to walk the list
+    Sessions apps;
+    std::unordered_map<Session*, Sessions::iterator> index;
     mutable std::mutex guard;
 };
 
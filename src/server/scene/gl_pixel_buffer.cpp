@@ -21,6 +21,7 @@
 #include "mir/renderer/gl/context.h"
 #include "mir/renderer/gl/texture_source.h"
 
+#include <algorithm>
 #include <stdexcept>
 #include <boost/throw_exception.hpp>
 #include MIR_SERVER_GL_H
@@ -136,28 +137,16 @@ void const* ms::GLPixelBuffer::as_argb_8888()
         auto const stride_val = stride().as_uint32_t();
         auto const height = size_.height.as_uint32_t();
 
-        std::vector<char> tmp(stride_val);
-
+        /* Flip (and convert) in place, a pair of lines at a time */
         for (unsigned int i = 0; i < height / 2; i++)
         {
-            /* Store line i */
-            tmp.assign(&pixels[i * stride_val], &pixels[(i + 1) * stride_val]);
-
-            /* Copy line height - i - 1 to line i */
-            copy_and_convert_pixel_line(&pixels[(height - i - 1) * stride_val],
-                                        &pixels[i * stride_val]);
-
-            /* Copy stored line (i) to height - i - 1 */
-            copy_and_convert_pixel_line(tmp.data(),
-                                        &pixels[(height - i - 1) * stride_val]);
+            swap_and_convert_pixel_lines(&pixels[i * stride_val],
+                                         &pixels[(height - i - 1) * stride_val]);
         }
 
         /* Process middle line if there is one */
         if (height % 2 == 1)
-        {
-            copy_and_convert_pixel_line(&pixels[(height / 2) * stride_val],
-                                        &pixels[(height / 2) * stride_val]);
-        }
+            convert_pixel_line(&pixels[(height / 2) * stride_val]);
 
         pixels_need_y_flip = false;
     }
@@ -175,20 +164,37 @@ geom::Stride ms::GLPixelBuffer::stride() const
     return geom::Stride{size_.width.as_uint32_t() * sizeof(uint32_t)};
 }
 
-void ms::GLPixelBuffer::copy_and_convert_pixel_line(char* src, char* dst)
+void ms::GLPixelBuffer::swap_and_convert_pixel_lines(char* a, char* b)
 {
     if (gl_pixel_format == GL_RGBA)
     {
-        /* Convert from abgr_8888 to argb_8888 while copying */
-        auto pixels_src = reinterpret_cast<uint32_t*>(src);
-        auto pixels_dst = reinterpret_cast<uint32_t*>(dst);
+        /* Convert from abgr_8888 to argb_8888 while swapping */
+        auto pixels_a = reinterpret_cast<uint32_t*>(a);
+        auto pixels_b = reinterpret_cast<uint32_t*>(b);
         auto const width = size_.width.as_uint32_t();
 
         for (uint32_t n = 0; n < width; n++)
-            pixels_dst[n] = abgr_to_argb(pixels_src[n]);
+        {
+            auto const tmp = abgr_to_argb(pixels_a[n]);
+            pixels_a[n] = abgr_to_argb(pixels_b[n]);
+            pixels_b[n] = tmp;
+        }
+    }
+    else
+    {
+        std::swap_ranges(a, a + stride().as_uint32_t(), b);
     }
-    else if (src != dst)
+}
+
+void ms::GLPixelBuffer::convert_pixel_line(char* line)
+{
+    if (gl_pixel_format == GL_RGBA)
     {
-        std::copy(src, src + stride().as_uint32_t(), dst);
+        /* Convert from abgr_8888 to argb_8888 in place */
+        auto pixels_line = reinterpret_cast<uint32_t*>(line);
+        auto const width = size_.width.as_uint32_t();
+
+        for (uint32_t n = 0; n < width; n++)
+            pixels_line[n] = abgr_to_argb(pixels_line[n]);
     }
 }
@@ -56,7 +56,8 @@ public:
 
 private:
     void prepare();
-    void copy_and_convert_pixel_line(char* src, char* dst);
+    void swap_and_convert_pixel_lines(char* a, char* b);
+    void convert_pixel_line(char* line);
 
     std::unique_ptr<renderer::gl::Context> const gl_context;
     GLuint tex;
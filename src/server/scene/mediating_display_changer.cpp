@@ -19,6 +19,7 @@
 #include <condition_variable>
 #include <boost/throw_exception.hpp>
 #include <unordered_set>
+#include <vector>
 #include "mediating_display_changer.h"
 #include "mir/scene/session_container.h"
 #include "mir/scene/session.h"
@@ -182,6 +183,7 @@ ms::MediatingDisplayChanger::MediatingDisplayChanger(
       observer{observer},
       base_configuration_{display->configuration()},
       base_configuration_applied{true},
+      applied_configuration{base_configuration_},
       alarm_factory{alarm_factory},
       session_observer{std::make_unique<SessionObserver>(this)}
 {
@@ -205,7 +207,7 @@ void ms::MediatingDisplayChanger::configure(
 
     {
         std::lock_guard<std::mutex> lg{configuration_mutex};
-        config_map[session] = conf;
+        config_map[session] = {conf, same_outputs(*base_configuration_, *conf)};
         observer->session_configuration_applied(session, conf);
 
         if (session != focused_session.lock())
@@ -400,6 +402,9 @@ void ms::MediatingDisplayChanger::configure_for_hardware_change(
 
             auto existing_configuration = base_configuration_;
 
+            /* The hardware has changed under whatever we last applied */
+            applied_configuration.reset();
+
             display_configuration_policy->apply_to(*conf);
             base_configuration_ = conf;
             if (base_configuration_applied)
@@ -465,21 +470,98 @@ bool configuration_has_new_outputs_enabled(
 }
 }
 
+bool ms::MediatingDisplayChanger::same_outputs(
+    mg::DisplayConfiguration const& lhs,
+    mg::DisplayConfiguration const& rhs)
+{
+    std::vector<mg::DisplayConfigurationOutput> lhs_outputs;
+    std::vector<mg::DisplayConfigurationOutput> rhs_outputs;
+    lhs.for_each_output([&](mg::DisplayConfigurationOutput const& output) { lhs_outputs.push_back(output); });
+    rhs.for_each_output([&](mg::DisplayConfigurationOutput const& output) { rhs_outputs.push_back(output); });
+
+    if (lhs_outputs.size() != rhs_outputs.size())
+        return false;
+
+    for (size_t i = 0; i != lhs_outputs.size(); ++i)
+    {
+        auto const& l = lhs_outputs[i];
+        auto const& r = rhs_outputs[i];
+
+        // operator== doesn't compare the subpixel arrangement or gamma
+        if (l != r ||
+            l.subpixel_arrangement != r.subpixel_arrangement ||
+            l.gamma.red != r.gamma.red ||
+            l.gamma.green != r.gamma.green ||
+            l.gamma.blue != r.gamma.blue)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ms::MediatingDisplayChanger::already_applied(
+    std::shared_ptr<mg::DisplayConfiguration> const& conf) const
+{
+    if (!applied_configuration)
+        return false;
+
+    if (conf == applied_configuration)
+        return true;
+
+    /* Focus moving between a session and the base configuration was compared in advance */
+    for (auto const& entry : config_map)
+    {
+        auto const& session_configuration = entry.second;
+
+        if ((session_configuration.conf == conf && applied_configuration == base_configuration_) ||
+            (session_configuration.conf == applied_configuration && conf == base_configuration_))
+        {
+            return session_configuration.same_as_base;
+        }
+    }
+
+    return same_outputs(*applied_configuration, *conf);
+}
+
 void ms::MediatingDisplayChanger::apply_config(
     std::shared_ptr<graphics::DisplayConfiguration> const& conf)
 {
-    auto existing_configuration = display->configuration();
+    if (already_applied(conf))
+    {
+        applied_configuration = conf;
+        observer->configuration_applied(conf);
+        base_configuration_applied = false;
+        return;
+    }
+
+    std::shared_ptr<mg::DisplayConfiguration> existing_configuration{display->configuration()};
     try
     {
-        if (configuration_has_new_outputs_enabled(*display->configuration(), *conf) ||
+        if (configuration_has_new_outputs_enabled(*existing_configuration, *conf) ||
             !display->apply_if_configuration_preserves_display_buffers(*conf))
         {
-            ApplyNowAndRevertOnScopeExit comp{
-                [this] { compositor->stop(); },
-                [this] { compositor->start(); }};
-            display->configure(*conf);
+            /*
+             * Where the display supports it only the outputs that change are
+             * rebuilt, and every other output keeps compositing throughout.
+             */
+            if (display->configure_changed_outputs(
+                    *conf,
+                    [this](mg::DisplaySyncGroup& group) { compositor->remove_display_sync_group(group); }))
+            {
+                compositor->add_display_sync_groups();
+            }
+            else
+            {
+                ApplyNowAndRevertOnScopeExit comp{
+                    [this] { compositor->stop(); },
+                    [this] { compositor->start(); }};
+                display->configure(*conf);
+            }
         }
 
+        applied_configuration = conf;
         observer->configuration_applied(conf);
         base_configuration_applied = false;
     }
@@ -498,9 +580,11 @@ void ms::MediatingDisplayChanger::apply_config(
                 [this] { compositor->stop(); },
                 [this] { compositor->start(); }};
             display->configure(*existing_configuration);
+            applied_configuration = existing_configuration;
         }
         catch (std::exception const& e)
         {
+            applied_configuration.reset();
             observer->catastrophic_configuration_error(std::move(existing_configuration), e);
             throw;
         }
@@ -542,7 +626,7 @@ void ms::MediatingDisplayChanger::focus_change_handler(
     {
         try
         {
-            apply_config(it->second);
+            apply_config(it->second.conf);
         }
         catch (std::exception const&)
         {
@@ -592,6 +676,9 @@ void ms::MediatingDisplayChanger::set_base_configuration(std::shared_ptr<mg::Dis
             if (base_configuration_applied)
                 apply_base_config();
 
+            for (auto& entry : config_map)
+                entry.second.same_as_base = same_outputs(*base_configuration_, *entry.second.conf);
+
             observer->base_configuration_updated(conf);
             send_config_to_all_sessions(conf);
         });
@@ -94,6 +94,18 @@ public:
     void set_base_configuration(std::shared_ptr<graphics::DisplayConfiguration> const &conf) override;
 
 private:
+    /// A session's configuration, and whether it is the same as the base configuration
+    struct SessionConfiguration
+    {
+        std::shared_ptr<graphics::DisplayConfiguration> conf;
+        bool same_as_base;
+    };
+
+    static bool same_outputs(
+        graphics::DisplayConfiguration const& lhs,
+        graphics::DisplayConfiguration const& rhs);
+    bool already_applied(std::shared_ptr<graphics::DisplayConfiguration> const& conf) const;
+
     void focus_change_handler(std::shared_ptr<Session> const& session);
     void no_focus_handler();
     void session_stopping_handler(std::shared_ptr<Session> const& session);
@@ -112,11 +124,13 @@ private:
     std::shared_ptr<graphics::DisplayConfigurationObserver> const observer;
     std::mutex configuration_mutex;
     std::map<std::weak_ptr<frontend::Session>,
-             std::shared_ptr<graphics::DisplayConfiguration>,
+             SessionConfiguration,
              std::owner_less<std::weak_ptr<frontend::Session>>> config_map;
     std::weak_ptr<frontend::Session> focused_session;
     std::shared_ptr<graphics::DisplayConfiguration> base_configuration_;
     bool base_configuration_applied;
+    // What the display was last configured with, or null if that isn't known
+    std::shared_ptr<graphics::DisplayConfiguration> applied_configuration;
     std::shared_ptr<time::AlarmFactory> const alarm_factory;
     std::unique_ptr<time::Alarm> preview_configuration_timeout;
     std::weak_ptr<frontend::Session> currently_previewing_session;
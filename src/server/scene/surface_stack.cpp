@@ -221,6 +221,11 @@ void ms::SurfaceStack::emit_scene_changed()
     observers.scene_changed();
 }
 
+void ms::SurfaceStack::emit_scene_damaged(geometry::Rectangle const& damage)
+{
+    observers.scene_damaged(damage);
+}
+
 void ms::SurfaceStack::add_surface(
     std::shared_ptr<Surface> const& surface,
     mi::InputReceptionMode input_mode)
@@ -410,6 +415,12 @@ void ms::Observers::scene_changed()
         { observer->scene_changed(); });
 }
 
+void ms::Observers::scene_damaged(geometry::Rectangle const& damage)
+{
+   for_each([&](std::shared_ptr<Observer> const& observer)
+        { observer->scene_damaged(damage); });
+}
+
 void ms::Observers::surface_exists(ms::Surface* surface)
 {
     for_each([&](std::shared_ptr<Observer> const& observer)
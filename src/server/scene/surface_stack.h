@@ -57,6 +57,7 @@ public:
    void surface_removed(Surface* surface) override;
    void surfaces_reordered() override;
    void scene_changed() override;
+   void scene_damaged(geometry::Rectangle const& damage) override;
    void surface_exists(Surface* surface) override;
    void end_observation() override;
 
@@ -100,6 +101,7 @@ public:
     void remove_input_visualization(std::weak_ptr<graphics::Renderable> const& overlay) override;
     
     void emit_scene_changed() override;
+    void emit_scene_damaged(geometry::Rectangle const& damage) override;
 
 private:
     SurfaceStack(const SurfaceStack&) = delete;
@@ -20,6 +20,8 @@
 #include "pixel_buffer.h"
 #include "mir/compositor/buffer_stream.h"
 #include "mir/thread_name.h"
+#include "mir/unwind_helpers.h"
+#include "mir/log.h"
 
 #include <deque>
 #include <mutex>
@@ -39,15 +41,10 @@ struct WorkItem
     ms::SnapshotCallback const snapshot_taken;
 };
 
-class SnapshottingFunctor
+class SnapshotWorkQueue
 {
 public:
-    SnapshottingFunctor(std::shared_ptr<PixelBuffer> const& pixels)
-        : running{true}, pixels{pixels}
-    {
-    }
-
-    void operator()()
+    void run_worker(PixelBuffer& pixels)
     {
         mir::set_thread_name("Mir/Snapshot");
         std::unique_lock<std::mutex> lock{work_mutex};
@@ -64,23 +61,34 @@ public:
 
                 lock.unlock();
 
-                take_snapshot(wi);
+                take_snapshot(pixels, wi);
 
                 lock.lock();
             }
         }
     }
 
-    void take_snapshot(WorkItem const& wi)
+    /// Returns false if stopped before there is any work
+    bool wait_for_work()
     {
-        wi.stream->with_most_recent_buffer_do([this](mir::graphics::Buffer& buffer) {
-            pixels->fill_from(buffer);
-        });
+        std::unique_lock<std::mutex> lock{work_mutex};
 
-        wi.snapshot_taken(
-            ms::Snapshot{pixels->size(),
-                     pixels->stride(),
-                     pixels->as_argb_8888()});
+        while (running && work.empty())
+            work_cv.wait(lock);
+
+        return running;
+    }
+
+    /// Answers every waiting request with an empty snapshot
+    void fail_waiting_work()
+    {
+        std::unique_lock<std::mutex> lock{work_mutex};
+        std::deque<WorkItem> failed;
+        swap(failed, work);
+        lock.unlock();
+
+        for (auto const& wi : failed)
+            wi.snapshot_taken(ms::Snapshot{{}, {}, nullptr});
     }
 
     void schedule_snapshot(WorkItem const& wi)
@@ -94,12 +102,23 @@ public:
     {
         std::lock_guard<std::mutex> lg{work_mutex};
         running = false;
-        work_cv.notify_one();
+        work_cv.notify_all();
     }
 
 private:
-    bool running;
-    std::shared_ptr<PixelBuffer> const pixels;
+    static void take_snapshot(PixelBuffer& pixels, WorkItem const& wi)
+    {
+        wi.stream->with_most_recent_buffer_do([&pixels](mir::graphics::Buffer& buffer) {
+            pixels.fill_from(buffer);
+        });
+
+        wi.snapshot_taken(
+            ms::Snapshot{pixels.size(),
+                     pixels.stride(),
+                     pixels.as_argb_8888()});
+    }
+
+    bool running{true};
     std::mutex work_mutex;
     std::condition_variable work_cv;
     std::deque<WorkItem> work;
@@ -110,21 +129,96 @@ private:
 
 ms::ThreadedSnapshotStrategy::ThreadedSnapshotStrategy(
     std::shared_ptr<PixelBuffer> const& pixels)
-    : pixels{pixels},
-      functor{new SnapshottingFunctor{pixels}},
-      thread{std::ref(*functor)}
+    : ThreadedSnapshotStrategy{std::vector<std::shared_ptr<PixelBuffer>>{pixels}}
+{
+}
+
+ms::ThreadedSnapshotStrategy::ThreadedSnapshotStrategy(
+    std::vector<std::shared_ptr<PixelBuffer>> const& pixels)
+    : work_queue{new SnapshotWorkQueue}
+{
+    auto const stop_on_unwind = on_unwind([this]
+        {
+            work_queue->stop();
+            for (auto& thread : threads)
+                thread.join();
+        });
+
+    start_workers(pixels);
+}
+
+ms::ThreadedSnapshotStrategy::ThreadedSnapshotStrategy(
+    std::function<std::vector<std::shared_ptr<PixelBuffer>>()> const& make_pixel_buffers)
+    : work_queue{new SnapshotWorkQueue}
 {
+    threads.emplace_back([this, make_pixel_buffers] { create_workers_and_run(make_pixel_buffers); });
 }
 
 ms::ThreadedSnapshotStrategy::~ThreadedSnapshotStrategy() noexcept
 {
-    functor->stop();
-    thread.join();
+    work_queue->stop();
+    for (auto& thread : threads)
+        thread.join();
+    for (auto& thread : further_threads)
+        thread.join();
 }
 
 void ms::ThreadedSnapshotStrategy::take_snapshot_of(
     std::shared_ptr<compositor::BufferStream> const& surface_buffer_access,
     SnapshotCallback const& snapshot_taken)
 {
-    functor->schedule_snapshot(WorkItem{surface_buffer_access, snapshot_taken});
+    work_queue->schedule_snapshot(WorkItem{surface_buffer_access, snapshot_taken});
+}
+
+void ms::ThreadedSnapshotStrategy::start_workers(std::vector<std::shared_ptr<PixelBuffer>> const& pixels)
+{
+    for (auto const& p : pixels)
+        threads.emplace_back([queue = work_queue.get(), p] { queue->run_worker(*p); });
+}
+
+void ms::ThreadedSnapshotStrategy::create_workers_and_run(
+    std::function<std::vector<std::shared_ptr<PixelBuffer>>()> const& make_pixel_buffers)
+{
+    mir::set_thread_name("Mir/Snapshot");
+
+    std::vector<std::shared_ptr<PixelBuffer>> pixels;
+
+    while (pixels.empty())
+    {
+        if (!work_queue->wait_for_work())
+            return;
+
+        try
+        {
+            pixels = make_pixel_buffers();
+        }
+        catch (...)
+        {
+            mir::log(
+                mir::logging::Severity::error,
+                MIR_LOG_COMPONENT,
+                std::current_exception(),
+                "Failed to create pixel buffers for snapshots");
+        }
+
+        if (pixels.empty())
+            work_queue->fail_waiting_work();
+    }
+
+    try
+    {
+        for (auto p = pixels.begin() + 1; p != pixels.end(); ++p)
+            further_threads.emplace_back([queue = work_queue.get(), pixel_buffer = *p] { queue->run_worker(*pixel_buffer); });
+    }
+    catch (...)
+    {
+        // Carry on with the workers we have
+        mir::log(
+            mir::logging::Severity::warning,
+            MIR_LOG_COMPONENT,
+            std::current_exception(),
+            "Failed to start all snapshot workers");
+    }
+
+    work_queue->run_worker(*pixels.front());
 }
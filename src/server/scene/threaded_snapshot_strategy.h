@@ -24,18 +24,36 @@
 #include <memory>
 #include <thread>
 #include <functional>
+#include <vector>
 
 namespace mir
 {
 namespace scene
 {
 class PixelBuffer;
-class SnapshottingFunctor;
+class SnapshotWorkQueue;
 
+/**
+ * Takes snapshots on dedicated "Mir/Snapshot" threads.
+ *
+ * One worker thread is started for each PixelBuffer provided; the workers
+ * share a single queue of snapshot requests, so several requests can be
+ * serviced concurrently.
+ *
+ * When given a factory instead, a single worker is started and creates the
+ * PixelBuffers (and so any GL contexts) itself when the first snapshot is
+ * requested, keeping them off the startup path and off the requesting thread.
+ * It then starts a worker for each further PixelBuffer. If the factory fails
+ * the waiting requests are answered with an empty Snapshot, and the factory
+ * is tried again on the next request.
+ */
 class ThreadedSnapshotStrategy : public SnapshotStrategy
 {
 public:
     ThreadedSnapshotStrategy(std::shared_ptr<PixelBuffer> const& pixels);
+    ThreadedSnapshotStrategy(std::vector<std::shared_ptr<PixelBuffer>> const& pixels);
+    ThreadedSnapshotStrategy(
+        std::function<std::vector<std::shared_ptr<PixelBuffer>>()> const& make_pixel_buffers);
     ~ThreadedSnapshotStrategy() noexcept;
 
     void take_snapshot_of(
@@ -43,9 +61,14 @@ public:
         SnapshotCallback const& snapshot_taken);
 
 private:
-    std::shared_ptr<PixelBuffer> const pixels;
-    std::unique_ptr<SnapshottingFunctor> functor;
-    std::thread thread;
+    void start_workers(std::vector<std::shared_ptr<PixelBuffer>> const& pixels);
+    void create_workers_and_run(
+        std::function<std::vector<std::shared_ptr<PixelBuffer>>()> const& make_pixel_buffers);
+
+    std::unique_ptr<SnapshotWorkQueue> const work_queue;
+    std::vector<std::thread> threads;
+    /// Only touched by the first worker, until it has been joined
+    std::vector<std::thread> further_threads;
 };
 
 }
@@ -21,20 +21,34 @@
 #include "mir/scene/session.h"
 
 #include "mir/time/alarm_factory.h"
+#include "mir/time/clock.h"
+
+#include <algorithm>
 
 namespace ms = mir::scene;
 namespace mt = mir::time;
 
+namespace
+{
+// The number of slots the ping cycle is divided into
+unsigned const slot_count = 16;
+
+// A slot takes new sessions (to ping them a full period later) until it has at least this many
+std::size_t const min_slot_size = 8;
+}
+
 struct ms::TimeoutApplicationNotRespondingDetector::ANRContext
 {
-    ANRContext(std::function<void()> const& pinger)
+    ANRContext(std::function<void()> const& pinger, unsigned slot)
         : pinger{pinger},
+          slot{slot},
           replied_since_last_ping{true},
           flagged_as_unresponsive{false}
     {
     }
 
     std::function<void()> const pinger;
+    unsigned const slot;
     bool replied_since_last_ping;
     bool flagged_as_unresponsive;
 };
@@ -53,9 +67,13 @@ void ms::TimeoutApplicationNotRespondingDetector::ANRObservers::session_now_resp
 
 ms::TimeoutApplicationNotRespondingDetector::TimeoutApplicationNotRespondingDetector(
     mt::AlarmFactory& alarms,
+    std::shared_ptr<mt::Clock> const& clock,
     std::chrono::milliseconds period)
-    : period{period},
-      alarm{alarms.create_alarm(std::bind(&TimeoutApplicationNotRespondingDetector::handle_ping_cycle, this))}
+    : slots(slot_count),
+      clock{clock},
+      period{period},
+      alarm_due{mt::Timestamp::max()},
+      alarm{alarms.create_alarm(std::bind(&TimeoutApplicationNotRespondingDetector::handle_due_slots, this))}
 {
 }
 
@@ -66,15 +84,27 @@ ms::TimeoutApplicationNotRespondingDetector::~TimeoutApplicationNotRespondingDet
 void ms::TimeoutApplicationNotRespondingDetector::register_session(
     frontend::Session const* session, std::function<void()> const& pinger)
 {
-    bool alarm_needs_schedule;
+    auto const scene_session = dynamic_cast<Session const*>(session);
+    auto const now = clock->now();
+    mt::Timestamp reschedule_for;
     {
         std::lock_guard<std::mutex> lock{session_mutex};
-        sessions[dynamic_cast<Session const*>(session)] = std::make_unique<ANRContext>(pinger);
-        alarm_needs_schedule = alarm->state() != mt::Alarm::State::pending;
+
+        remove_session_locked(scene_session);
+
+        if (alarm_due == mt::Timestamp::max())
+            restart_wheel_locked(now);
+
+        auto const slot = slot_for_new_session_locked();
+        sessions[scene_session] = std::make_unique<ANRContext>(pinger, slot);
+        slots[slot].members.insert(scene_session);
+        ++slots[slot].active;
+
+        reschedule_for = schedule_locked(slots[slot].due);
     }
-    if (alarm_needs_schedule)
+    if (reschedule_for != mt::Timestamp::max())
     {
-        alarm->reschedule_in(period);
+        alarm->reschedule_for(reschedule_for);
     }
 }
 
@@ -82,14 +112,15 @@ void ms::TimeoutApplicationNotRespondingDetector::unregister_session(
     frontend::Session const* session)
 {
     std::lock_guard<std::mutex> lock{session_mutex};
-    sessions.erase(dynamic_cast<Session const*>(session));
+    remove_session_locked(dynamic_cast<Session const*>(session));
 }
 
 void ms::TimeoutApplicationNotRespondingDetector::pong_received(
    frontend::Session const* received_for)
 {
     bool needs_now_responsive_notification{false};
-    bool alarm_needs_rescheduling;
+    auto const now = clock->now();
+    mt::Timestamp reschedule_for{mt::Timestamp::max()};
     {
         std::lock_guard<std::mutex> lock{session_mutex};
 
@@ -98,18 +129,23 @@ void ms::TimeoutApplicationNotRespondingDetector::pong_received(
         {
             session_ctx->flagged_as_unresponsive = false;
             needs_now_responsive_notification = true;
+
+            if (alarm_due == mt::Timestamp::max())
+                restart_wheel_locked(now);
+
+            auto& slot = slots[session_ctx->slot];
+            ++slot.active;
+            reschedule_for = schedule_locked(slot.due);
         }
         session_ctx->replied_since_last_ping = true;
-
-        alarm_needs_rescheduling = alarm->state() != mt::Alarm::State::pending;
     }
     if (needs_now_responsive_notification)
     {
         observers.session_now_responsive(dynamic_cast<Session const*>(received_for));
     }
-    if (alarm_needs_rescheduling)
+    if (reschedule_for != mt::Timestamp::max())
     {
-        alarm->reschedule_in(period);
+        alarm->reschedule_for(reschedule_for);
     }
 }
 
@@ -142,31 +178,47 @@ void ms::TimeoutApplicationNotRespondingDetector::unregister_observer(
     observers.remove(observer);
 }
 
-void ms::TimeoutApplicationNotRespondingDetector::handle_ping_cycle()
+void ms::TimeoutApplicationNotRespondingDetector::handle_due_slots()
 {
-    bool needs_rearm{false};
+    auto const now = clock->now();
+    mt::Timestamp reschedule_for;
     {
         std::lock_guard<std::mutex> lock{session_mutex};
-        for (auto const& session_pair : sessions)
+        for (auto& slot : slots)
         {
-            bool const newly_unresponsive =
-                !session_pair.second->replied_since_last_ping &&
-                !session_pair.second->flagged_as_unresponsive;
-            bool const needs_ping =
-                session_pair.second->replied_since_last_ping;
+            if (slot.due > now)
+                continue;
 
-            if (newly_unresponsive)
-            {
-                session_pair.second->flagged_as_unresponsive = true;
-                unresponsive_sessions_temporary.push_back(session_pair.first);
-            }
-            else if (needs_ping)
+            for (auto const session : slot.members)
             {
-                session_pair.second->pinger();
-                session_pair.second->replied_since_last_ping = false;
-                needs_rearm = true;
+                auto& session_ctx = *sessions.at(session);
+
+                bool const newly_unresponsive =
+                    !session_ctx.replied_since_last_ping &&
+                    !session_ctx.flagged_as_unresponsive;
+                bool const needs_ping =
+                    session_ctx.replied_since_last_ping;
+
+                if (newly_unresponsive)
+                {
+                    session_ctx.flagged_as_unresponsive = true;
+                    --slot.active;
+                    unresponsive_sessions_temporary.push_back(session);
+                }
+                else if (needs_ping)
+                {
+                    session_ctx.pinger();
+                    session_ctx.replied_since_last_ping = false;
+                }
             }
+
+            // If we've been held up, skip the missed cycles rather than trying to catch up
+            while (slot.due <= now)
+                slot.due += period;
         }
+
+        alarm_due = next_due_locked();
+        reschedule_for = alarm_due;
     }
 
     // Dispatch notifications outside the lock.
@@ -177,8 +229,74 @@ void ms::TimeoutApplicationNotRespondingDetector::handle_ping_cycle()
 
     unresponsive_sessions_temporary.clear();
 
-    if (needs_rearm)
+    if (reschedule_for != mt::Timestamp::max())
     {
-        this->alarm->reschedule_in(this->period);
+        this->alarm->reschedule_for(reschedule_for);
     }
 }
+
+void ms::TimeoutApplicationNotRespondingDetector::restart_wheel_locked(mt::Timestamp now)
+{
+    // Slot 0 comes round last, a full period from now: new sessions go there first
+    auto const slot_interval = std::chrono::duration_cast<mt::Duration>(period) / slot_count;
+
+    slots[0].due = now + period;
+    for (auto i = 1u; i != slots.size(); ++i)
+        slots[i].due = now + i*slot_interval;
+}
+
+auto ms::TimeoutApplicationNotRespondingDetector::slot_for_new_session_locked() -> unsigned
+{
+    // Pinging a new session a period after it connects is the natural schedule, so use the
+    // slot that has just been handled while it has no more than its fair share of sessions...
+    auto const by_due = [](Slot const& lhs, Slot const& rhs) { return lhs.due < rhs.due; };
+    auto const latest = std::max_element(slots.begin(), slots.end(), by_due);
+    auto const fair_share = std::max(min_slot_size, (sessions.size() + slots.size()) / slots.size());
+
+    if (latest->members.size() < fair_share)
+        return latest - slots.begin();
+
+    // ...otherwise spread sessions (such as a burst of connections) over the least busy slots
+    auto const by_size = [](Slot const& lhs, Slot const& rhs)
+        {
+            return lhs.members.size() < rhs.members.size() ||
+                (lhs.members.size() == rhs.members.size() && lhs.due > rhs.due);
+        };
+    return std::min_element(slots.begin(), slots.end(), by_size) - slots.begin();
+}
+
+void ms::TimeoutApplicationNotRespondingDetector::remove_session_locked(Session const* session)
+{
+    auto const i = sessions.find(session);
+    if (i == sessions.end())
+        return;
+
+    auto& slot = slots[i->second->slot];
+    slot.members.erase(session);
+    if (!i->second->flagged_as_unresponsive)
+        --slot.active;
+
+    sessions.erase(i);
+}
+
+auto ms::TimeoutApplicationNotRespondingDetector::schedule_locked(mt::Timestamp slot_due) -> mt::Timestamp
+{
+    if (slot_due >= alarm_due)
+        return mt::Timestamp::max();
+
+    alarm_due = slot_due;
+    return alarm_due;
+}
+
+auto ms::TimeoutApplicationNotRespondingDetector::next_due_locked() const -> mt::Timestamp
+{
+    auto result = mt::Timestamp::max();
+
+    for (auto const& slot : slots)
+    {
+        if (slot.active && slot.due < result)
+            result = slot.due;
+    }
+
+    return result;
+}
@@ -21,10 +21,13 @@
 
 #include "mir/scene/application_not_responding_detector.h"
 #include "mir/basic_observers.h"
+#include "mir/time/types.h"
 
 #include <chrono>
 #include <unordered_map>
+#include <unordered_set>
 #include <functional>
+#include <vector>
 
 namespace mir
 {
@@ -32,22 +35,31 @@ namespace time
 {
 class Alarm;
 class AlarmFactory;
+class Clock;
 }
 
 namespace scene
 {
+/**
+ * Pings each session once a period and reports those that haven't replied by the next.
+ *
+ * Rather than pinging every session at once, sessions are spread over a wheel of
+ * slots staggered through the period, and a wakeup only handles the slots that are due.
+ */
 class TimeoutApplicationNotRespondingDetector : public ApplicationNotRespondingDetector
 {
 public:
     TimeoutApplicationNotRespondingDetector(
         time::AlarmFactory& alarms,
+        std::shared_ptr<time::Clock> const& clock,
         std::chrono::milliseconds period);
 
     template<typename Rep, typename Period>
     TimeoutApplicationNotRespondingDetector(
         time::AlarmFactory& alarms,
+        std::shared_ptr<time::Clock> const& clock,
         std::chrono::duration<Rep, Period> period)
-        : TimeoutApplicationNotRespondingDetector(alarms,
+        : TimeoutApplicationNotRespondingDetector(alarms, clock,
               std::chrono::duration_cast<std::chrono::milliseconds>(period))
     {
     }
@@ -64,10 +76,24 @@ public:
     void register_observer(std::shared_ptr<Observer> const& observer) override;
     void unregister_observer(std::shared_ptr<Observer> const& observer) override;
 private:
-    void handle_ping_cycle();
+    void handle_due_slots();
 
     struct ANRContext;
 
+    struct Slot
+    {
+        std::unordered_set<Session const*> members;
+        unsigned active{0};     ///< members not flagged as unresponsive (which need the alarm)
+        time::Timestamp due;
+    };
+
+    void restart_wheel_locked(time::Timestamp now);
+    auto slot_for_new_session_locked() -> unsigned;
+    void remove_session_locked(Session const* session);
+    /// Brings the alarm forward to slot_due if needed: returns the new time, or Timestamp::max()
+    auto schedule_locked(time::Timestamp slot_due) -> time::Timestamp;
+    auto next_due_locked() const -> time::Timestamp;
+
     class ANRObservers : public Observer, private BasicObservers<Observer>
     {
     public:
@@ -80,9 +106,12 @@ private:
 
     std::mutex session_mutex;
     std::unordered_map<Session const*, std::unique_ptr<ANRContext>> sessions;
+    std::vector<Slot> slots;
     std::vector<Session const*> unresponsive_sessions_temporary;
 
+    std::shared_ptr<time::Clock> const clock;
     std::chrono::milliseconds const period;
+    time::Timestamp alarm_due;  ///< Timestamp::max() when the alarm isn't needed
     std::unique_ptr<time::Alarm> const alarm;
 };
 }
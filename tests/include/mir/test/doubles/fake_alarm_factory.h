@@ -46,6 +46,9 @@ public:
     void advance_smoothly_by(time::Duration step);
     int wakeup_count() const;
 
+    /// The clock the alarms run on
+    std::shared_ptr<time::Clock> the_clock() const;
+
 private:
     class FakeAlarm;
 
@@ -35,6 +35,8 @@ class MockCompositor : public compositor::Compositor
 public:
     MOCK_METHOD0(start, void());
     MOCK_METHOD0(stop, void());
+    MOCK_METHOD1(remove_display_sync_group, void(graphics::DisplaySyncGroup&));
+    MOCK_METHOD0(add_display_sync_groups, void());
 };
 
 }
@@ -39,6 +39,8 @@ public:
     MOCK_CONST_METHOD0(configuration, std::unique_ptr<graphics::DisplayConfiguration>());
     MOCK_METHOD1(apply_if_configuration_preserves_display_buffers, bool(graphics::DisplayConfiguration const&));
     MOCK_METHOD1(configure, void(graphics::DisplayConfiguration const&));
+    MOCK_METHOD2(configure_changed_outputs,
+                 bool(graphics::DisplayConfiguration const&, std::function<void(graphics::DisplaySyncGroup&)> const&));
     MOCK_METHOD2(register_configuration_change_handler,
                  void(graphics::EventHandlerRegister&, graphics::DisplayConfigurationChangeHandler const&));
 
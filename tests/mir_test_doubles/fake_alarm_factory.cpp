@@ -187,3 +187,8 @@ int mtd::FakeAlarmFactory::wakeup_count() const
             return count + alarm->wakeup_count();
         });
 }
+
+std::shared_ptr<mt::Clock> mtd::FakeAlarmFactory::the_clock() const
+{
+    return clock;
+}
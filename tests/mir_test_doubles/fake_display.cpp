@@ -22,6 +22,7 @@
 
 #include "mir/graphics/event_handler_register.h"
 
+#include <algorithm>
 #include <system_error>
 #include <boost/throw_exception.hpp>
 
@@ -76,6 +77,7 @@ mtd::FakeDisplay::FakeDisplay(std::vector<geometry::Rectangle> const& output_rec
     }
     for (auto const& rect : output_rects)
         groups.emplace_back(new StubDisplaySyncGroup({rect}));
+    group_outputs = config->outputs;
 }
 
 void mtd::FakeDisplay::for_each_display_sync_group(std::function<void(mir::graphics::DisplaySyncGroup&)> const& f)
@@ -140,6 +142,38 @@ void mtd::FakeDisplay::configure(mir::graphics::DisplayConfiguration const& new_
 
     swap(config, new_configuration);
     swap(groups, new_groups);
+    group_outputs = config->outputs;
+}
+
+bool mtd::FakeDisplay::configure_changed_outputs(
+    mir::graphics::DisplayConfiguration const& new_config,
+    std::function<void(mir::graphics::DisplaySyncGroup&)> const& removing_group)
+{
+    std::lock_guard<decltype(configuration_mutex)> lock{configuration_mutex};
+    decltype(config) new_configuration = std::make_shared<StubDisplayConfig>(new_config);
+    decltype(groups) new_groups;
+
+    new_configuration->for_each_output([&](mir::graphics::DisplayConfigurationOutput const& output)
+        {
+            auto const unchanged = std::find(begin(group_outputs), end(group_outputs), output);
+            auto const index = unchanged - begin(group_outputs);
+
+            if (unchanged != end(group_outputs) && groups[index])
+                new_groups.push_back(std::move(groups[index]));
+            else
+                new_groups.emplace_back(new StubDisplaySyncGroup({output.extents()}));
+        });
+
+    for (auto const& group : groups)
+    {
+        if (group)
+            removing_group(*group);
+    }
+
+    swap(config, new_configuration);
+    swap(groups, new_groups);
+    group_outputs = config->outputs;
+    return true;
 }
 
 void mtd::FakeDisplay::emit_configuration_change_event(
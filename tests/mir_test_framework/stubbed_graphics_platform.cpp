@@ -71,6 +71,12 @@ struct WrappingDisplay : mg::Display
     {
         display->configure(conf);
     }
+    bool configure_changed_outputs(
+        mg::DisplayConfiguration const& conf,
+        std::function<void(mg::DisplaySyncGroup&)> const& removing_group) override
+    {
+        return display->configure_changed_outputs(conf, removing_group);
+    }
     void register_configuration_change_handler(
         mg::EventHandlerRegister& handlers,
         mg::DisplayConfigurationChangeHandler const& conf_change_handler) override
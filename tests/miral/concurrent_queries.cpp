@@ -0,0 +1,107 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_window_manager_tools.h"
+
+#include <mir/test/signal.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace miral;
+using namespace testing;
+using namespace std::chrono_literals;
+namespace mt = mir::test;
+
+namespace
+{
+Rectangle const display_area{{0, 0}, {640, 480}};
+
+struct ConcurrentQueries : TestWindowManagerTools
+{
+    Window window;
+
+    void SetUp() override
+    {
+        basic_window_manager.add_display_for_testing(display_area);
+        basic_window_manager.add_session(session);
+
+        EXPECT_CALL(*window_manager_policy, advise_new_window(_))
+            .WillOnce(Invoke([this](WindowInfo const& window_info){ window = window_info.window(); }));
+
+        mir::scene::SurfaceCreationParameters creation_parameters;
+        creation_parameters.size = {100, 100};
+        basic_window_manager.add_surface(session, creation_parameters, &create_surface);
+
+        Mock::VerifyAndClearExpectations(window_manager_policy);
+    }
+};
+}
+
+TEST_F(ConcurrentQueries, shared_lock_callbacks_run_concurrently)
+{
+    mt::Signal first_reader_in;
+    mt::Signal second_reader_in;
+    std::atomic<bool> first_saw_second{false};
+
+    std::thread first_reader{[&]
+        {
+            window_manager_tools.invoke_under_shared_lock([&]
+                {
+                    first_reader_in.raise();
+                    first_saw_second = second_reader_in.wait_for(5s);
+                });
+        }};
+
+    window_manager_tools.invoke_under_shared_lock([&]
+        {
+            second_reader_in.raise();
+            EXPECT_TRUE(first_reader_in.wait_for(5s));
+        });
+
+    first_reader.join();
+    EXPECT_TRUE(first_saw_second);
+}
+
+TEST_F(ConcurrentQueries, shared_lock_callbacks_can_query_the_model)
+{
+    window_manager_tools.invoke_under_shared_lock([&]
+        {
+            EXPECT_THAT(window_manager_tools.count_applications(), Eq(1u));
+            EXPECT_THAT(window_manager_tools.info_for(window).window(), Eq(window));
+            EXPECT_THAT(window_manager_tools.info_for(session).windows(), ElementsAre(window));
+        });
+}
+
+TEST_F(ConcurrentQueries, updates_wait_for_shared_lock_callbacks)
+{
+    std::atomic<bool> updated{false};
+    std::thread writer;
+
+    window_manager_tools.invoke_under_shared_lock([&]
+        {
+            writer = std::thread{[&]
+                {
+                    window_manager_tools.invoke_under_lock([&] { updated = true; });
+                }};
+
+            std::this_thread::sleep_for(50ms);
+            EXPECT_FALSE(updated);
+        });
+
+    writer.join();
+    EXPECT_TRUE(updated);
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_window_manager_tools.h"
+#include "window_management_recorder.h"
+#include "window_management_replay.h"
+
+#include <miral/application_info.h>
+
+#include <mir/shell/surface_specification.h>
+
+#include <fstream>
+#include <sstream>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+using namespace miral;
+using namespace testing;
+
+namespace
+{
+Rectangle const display_area{{0, 0}, {800, 600}};
+
+struct NamedSession : StubStubSession
+{
+    explicit NamedSession(std::string const& name) : name_{name} {}
+
+    std::string name() const override { return name_; }
+
+    std::string const name_;
+};
+
+// A BasicWindowManager running a canonical policy under a WindowManagementRecorder
+struct RecordedWindowManager
+{
+    StubFocusController focus_controller;
+    StubDisplayLayout display_layout;
+    StubPersistentSurfaceStore persistent_surface_store;
+    StubDisplayConfigurationObserver display_configuration_observer;
+    std::shared_ptr<TraceRecordBuffer> const buffer{std::make_shared<TraceRecordBuffer>()};
+
+    BasicWindowManager window_manager{
+        &focus_controller,
+        mir::test::fake_shared(display_layout),
+        mir::test::fake_shared(persistent_surface_store),
+        display_configuration_observer,
+        [this](WindowManagerTools const& tools) -> std::unique_ptr<WindowManagementPolicy>
+            {
+                auto const build_policy = [](WindowManagerTools const& tools) -> std::unique_ptr<WindowManagementPolicy>
+                    {
+                        return std::make_unique<NiceMock<MockWindowManagerPolicy>>(tools);
+                    };
+
+                return std::make_unique<WindowManagementRecorder>(tools, build_policy, buffer, "");
+            }};
+
+    auto calls() const -> std::vector<TraceCall>
+    {
+        std::vector<TraceCall> result;
+        for (auto const& record : buffer->records())
+            result.push_back(record.call);
+        return result;
+    }
+
+    auto dump() const -> std::string
+    {
+        std::stringstream out;
+        dump_trace(out, buffer->records());
+        return out.str();
+    }
+};
+
+auto record_at(std::int64_t time) -> TraceRecord
+{
+    TraceRecord result{};
+    result.time = time;
+    return result;
+}
+
+auto times_of(std::vector<TraceRecord> const& records) -> std::vector<std::int64_t>
+{
+    std::vector<std::int64_t> result;
+    for (auto const& record : records)
+        result.push_back(record.time);
+    return result;
+}
+
+struct TemporaryFile
+{
+    TemporaryFile()
+    {
+        char name[] = "/tmp/miral-trace-XXXXXX";
+        close(mkstemp(name));
+        filename = name;
+    }
+
+    ~TemporaryFile() { unlink(filename.c_str()); }
+
+    std::string filename;
+};
+
+struct WindowManagementRecorderTest : Test
+{
+    RecordedWindowManager recorded;
+    std::shared_ptr<NamedSession> const session{std::make_shared<NamedSession>("terminal")};
+
+    void SetUp() override
+    {
+        recorded.window_manager.add_display_for_testing(display_area);
+        recorded.window_manager.add_session(session);
+    }
+
+    auto add_window(std::string const& name) -> std::shared_ptr<mir::scene::Surface>
+    {
+        mir::scene::SurfaceCreationParameters creation_parameters;
+        creation_parameters.name = name;
+        creation_parameters.type = mir_window_type_normal;
+        creation_parameters.size = {200, 100};
+
+        auto const id = recorded.window_manager.add_surface(
+            session, creation_parameters, &TestWindowManagerTools::create_surface);
+
+        return session->surface(id);
+    }
+};
+}
+
+TEST(TraceRecordBuffer, keeps_records_in_order)
+{
+    TraceRecordBuffer buffer{4};
+
+    for (auto time : {1, 2, 3})
+        buffer.push(record_at(time));
+
+    EXPECT_THAT(times_of(buffer.records()), ElementsAre(1, 2, 3));
+}
+
+TEST(TraceRecordBuffer, keeps_only_the_most_recent_records)
+{
+    TraceRecordBuffer buffer{4};
+
+    for (auto time : {1, 2, 3, 4, 5, 6})
+        buffer.push(record_at(time));
+
+    EXPECT_THAT(times_of(buffer.records()), ElementsAre(3, 4, 5, 6));
+}
+
+TEST(TraceRecordBuffer, records_survive_a_round_trip_through_a_file)
+{
+    TemporaryFile const file;
+    std::vector<TraceRecord> const records{record_at(1), record_at(2)};
+
+    save_trace(file.filename, records);
+    auto const loaded = load_trace(file.filename);
+
+    EXPECT_THAT(times_of(loaded), ElementsAre(1, 2));
+}
+
+TEST(TraceRecordBuffer, loading_something_else_throws)
+{
+    TemporaryFile const file;
+    std::ofstream{file.filename} << "This is not a window management trace";
+
+    EXPECT_THROW(load_trace(file.filename), std::runtime_error);
+}
+
+TEST_F(WindowManagementRecorderTest, records_new_windows_with_their_names)
+{
+    add_window("editor");
+
+    EXPECT_THAT(recorded.calls(), IsSupersetOf({
+        TraceCall::advise_new_app, TraceCall::window_name, TraceCall::place_new_window,
+        TraceCall::advise_new_window}));
+
+    auto const dump = recorded.dump();
+    EXPECT_THAT(dump, HasSubstr("advise_new_app application=terminal"));
+    EXPECT_THAT(dump, HasSubstr("advise_new_window window=editor application=terminal"));
+}
+
+TEST_F(WindowManagementRecorderTest, replay_reproduces_the_recorded_calls)
+{
+    auto const surface = add_window("editor");
+    add_window("browser");
+
+    mir::shell::SurfaceSpecification modifications;
+    modifications.width = mir::geometry::Width{300};
+    modifications.height = mir::geometry::Height{150};
+    recorded.window_manager.modify_surface(session, surface, modifications);
+
+    recorded.window_manager.remove_surface(session, surface);
+    recorded.window_manager.remove_session(session);
+
+    RecordedWindowManager replayed;
+    replayed.window_manager.add_display_for_testing(display_area);
+
+    WindowManagementReplay replay{
+        replayed.window_manager,
+        [](std::string const& name) { return std::make_shared<NamedSession>(name); },
+        [](std::shared_ptr<mir::scene::Surface> const&) {}};
+
+    for (auto const& record : recorded.buffer->records())
+        replay.replay(record);
+
+    EXPECT_THAT(replayed.calls(), Eq(recorded.calls()));
+    EXPECT_THAT(replayed.dump(), HasSubstr("handle_modify_window window=editor size=(300, 150)"));
+}
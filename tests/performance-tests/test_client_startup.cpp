@@ -55,6 +55,14 @@ struct ClientStartupPerformance : testing::Test, mtf::AsyncServerRunner
     }
 };
 
+struct ServerStartupPerformance : testing::Test, mtf::AsyncServerRunner
+{
+    void TearDown() override
+    {
+        stop_server();
+    }
+};
+
 MirPixelFormat find_pixel_format(MirConnection* connection)
 {
     MirPixelFormat pixel_format = mir_pixel_format_invalid;
@@ -119,3 +127,39 @@ TEST_F(ClientStartupPerformance, create_surface_and_swap)
     mir_connection_release(conn);
 }
 
+TEST_F(ServerStartupPerformance, time_to_first_client_frame)
+{
+    using namespace std::chrono_literals;
+    auto start = std::chrono::steady_clock::now();
+
+    start_server();
+    auto const server_started = std::chrono::steady_clock::now();
+
+    auto conn = mir_connect_sync(new_connection().c_str(), "Perf test");
+    ASSERT_THAT(conn, IsValid());
+
+    auto window = make_surface(conn);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    auto stream  = mir_window_get_buffer_stream(window);
+#pragma GCC diagnostic pop
+    ASSERT_TRUE(mir_buffer_stream_is_valid(stream));
+
+    mir_buffer_stream_swap_buffers_sync(stream);
+
+    auto end = std::chrono::steady_clock::now();
+    auto startup = std::chrono::duration_cast<std::chrono::milliseconds>(server_started-start);
+    auto first_frame = std::chrono::duration_cast<std::chrono::milliseconds>(end-start);
+
+    RecordProperty("server_startup_ms", static_cast<int>(startup.count()));
+    RecordProperty("time_to_first_frame_ms", static_cast<int>(first_frame.count()));
+
+    //NOTE: Ideally, the expected numbers should vary according to platform
+    auto max_expected_startup = 300ms;
+    auto max_expected_first_frame = max_expected_startup + 80ms;
+    EXPECT_THAT(startup.count(), Lt(max_expected_startup.count()));
+    EXPECT_THAT(first_frame.count(), Lt(max_expected_first_frame.count()));
+
+    mir_window_release_sync(window);
+    mir_connection_release(conn);
+}
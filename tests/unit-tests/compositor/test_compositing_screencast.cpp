@@ -25,6 +25,7 @@
 #include "mir/geometry/rectangle.h"
 #include "mir/geometry/rectangles.h"
 #include "mir/renderer/gl/render_target.h"
+#include "mir/scene/observer.h"
 
 #include "mir/test/doubles/null_display.h"
 #include "mir/test/doubles/null_display_buffer_compositor_factory.h"
@@ -32,6 +33,7 @@
 #include "mir/test/doubles/stub_gl_buffer_allocator.h"
 #include "mir/test/doubles/mock_buffer.h"
 #include "mir/test/doubles/mock_gl.h"
+#include "mir/test/doubles/mock_egl.h"
 #include "mir/test/doubles/stub_scene.h"
 #include "mir/test/doubles/stub_scene_element.h"
 #include "mir/test/doubles/mock_scene.h"
@@ -212,6 +214,7 @@ struct CompositingScreencastTest : testing::Test
     {
     }
 
+    testing::NiceMock<mtd::MockEGL> mock_egl;
     testing::NiceMock<mtd::MockGL> mock_gl;
     mtd::StubScene stub_scene;
     StubDisplay stub_display;
@@ -329,6 +332,88 @@ TEST_F(CompositingScreencastTest, captures_to_buffer_by_compositing)
     screencast.capture(session_id, mt::fake_shared(stub_buffer));
 }
 
+TEST_F(CompositingScreencastTest, does_not_recomposite_into_buffer_when_scene_is_unchanged)
+{
+    using namespace testing;
+
+    mtd::StubGLBuffer stub_buffer;
+    NiceMock<mtd::MockScene> mock_scene;
+    MockDisplayBufferCompositorFactory mock_db_compositor_factory;
+
+    EXPECT_CALL(mock_db_compositor_factory.mock_db_compositor, composite_(_))
+        .Times(1);
+
+    mc::CompositingScreencast screencast{
+        mt::fake_shared(mock_scene),
+        mt::fake_shared(stub_display),
+        mt::fake_shared(stub_buffer_allocator),
+        mt::fake_shared(mock_db_compositor_factory)};
+
+    auto session_id = screencast.create_session(
+        default_region, default_size, default_pixel_format,
+        0, default_mirror_mode);
+
+    screencast.capture(session_id, mt::fake_shared(stub_buffer));
+    screencast.capture(session_id, mt::fake_shared(stub_buffer));
+}
+
+TEST_F(CompositingScreencastTest, recomposites_into_buffer_after_scene_change)
+{
+    using namespace testing;
+
+    mtd::StubGLBuffer stub_buffer;
+    NiceMock<mtd::MockScene> mock_scene;
+    MockDisplayBufferCompositorFactory mock_db_compositor_factory;
+    std::shared_ptr<mir::scene::Observer> scene_observer;
+
+    EXPECT_CALL(mock_scene, add_observer(_))
+        .WillOnce(SaveArg<0>(&scene_observer));
+    EXPECT_CALL(mock_db_compositor_factory.mock_db_compositor, composite_(_))
+        .Times(2);
+
+    mc::CompositingScreencast screencast{
+        mt::fake_shared(mock_scene),
+        mt::fake_shared(stub_display),
+        mt::fake_shared(stub_buffer_allocator),
+        mt::fake_shared(mock_db_compositor_factory)};
+
+    auto session_id = screencast.create_session(
+        default_region, default_size, default_pixel_format,
+        0, default_mirror_mode);
+
+    screencast.capture(session_id, mt::fake_shared(stub_buffer));
+    ASSERT_THAT(scene_observer, NotNull());
+    scene_observer->scene_changed();
+    screencast.capture(session_id, mt::fake_shared(stub_buffer));
+}
+
+TEST_F(CompositingScreencastTest, recomposites_into_buffer_when_frames_are_pending)
+{
+    using namespace testing;
+
+    mtd::StubGLBuffer stub_buffer;
+    NiceMock<mtd::MockScene> mock_scene;
+    MockDisplayBufferCompositorFactory mock_db_compositor_factory;
+
+    ON_CALL(mock_scene, frames_pending(_))
+        .WillByDefault(Return(1));
+    EXPECT_CALL(mock_db_compositor_factory.mock_db_compositor, composite_(_))
+        .Times(2);
+
+    mc::CompositingScreencast screencast{
+        mt::fake_shared(mock_scene),
+        mt::fake_shared(stub_display),
+        mt::fake_shared(stub_buffer_allocator),
+        mt::fake_shared(mock_db_compositor_factory)};
+
+    auto session_id = screencast.create_session(
+        default_region, default_size, default_pixel_format,
+        0, default_mirror_mode);
+
+    screencast.capture(session_id, mt::fake_shared(stub_buffer));
+    screencast.capture(session_id, mt::fake_shared(stub_buffer));
+}
+
 TEST_F(CompositingScreencastTest, captures_to_buffer_by_compositing_with_reserve_buffers)
 {
     using namespace testing;
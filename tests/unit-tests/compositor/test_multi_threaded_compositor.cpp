@@ -34,10 +34,13 @@
 #include "mir/test/doubles/mock_scene.h"
 #include "mir/test/doubles/stub_scene.h"
 #include "mir/test/doubles/stub_display.h"
+#include "mir/test/doubles/fake_display.h"
+#include "mir/test/doubles/stub_display_configuration.h"
 #include "mir/test/doubles/null_display_buffer_compositor_factory.h"
 
 #include <boost/throw_exception.hpp>
 
+#include <map>
 #include <unordered_map>
 #include <unordered_set>
 #include <thread>
@@ -347,6 +350,43 @@ public:
 
 namespace
 {
+// Counts, per output position, the frames composited and compositors created
+class PerOutputDisplayBufferCompositorFactory : public mc::DisplayBufferCompositorFactory
+{
+public:
+    std::unique_ptr<mc::DisplayBufferCompositor> create_compositor_for(mg::DisplayBuffer& display_buffer)
+    {
+        auto const x = display_buffer.view_area().top_left.x.as_int();
+        {
+            std::lock_guard<std::mutex> lk{m};
+            ++compositors_created[x];
+        }
+        return std::make_unique<RecordingDisplayBufferCompositor>(
+            [this, x]
+            {
+                std::lock_guard<std::mutex> lk{m};
+                ++frames[x];
+            });
+    }
+
+    int frames_at(int x)
+    {
+        std::lock_guard<std::mutex> lk{m};
+        return frames[x];
+    }
+
+    int compositors_created_at(int x)
+    {
+        std::lock_guard<std::mutex> lk{m};
+        return compositors_created[x];
+    }
+
+private:
+    std::mutex m;
+    std::map<int, int> frames;
+    std::map<int, int> compositors_created;
+};
+
 struct StubDisplayListener : mc::DisplayListener
 {
     virtual void add_display(geom::Rectangle const& /*area*/) override {}
@@ -944,3 +984,62 @@ TEST(MultiThreadedCompositor, can_schedule_from_display_observer_when_removing_d
         display, stub_scene, db_compositor_factory, mock_display_listener, mock_report, default_delay, true};
     compositor.start();
 }
+
+TEST(MultiThreadedCompositor, reconfiguring_one_output_keeps_compositing_the_others)
+{
+    using namespace testing;
+    std::vector<geom::Rectangle> const rects{
+        {{0, 0}, {100, 100}}, {{100, 0}, {100, 100}}, {{200, 0}, {100, 100}}};
+    int const untouched[]{0, 200};
+    int const moved_from{100}, moved_to{300};
+    int const frames_wanted{10};
+
+    auto display = std::make_shared<mtd::FakeDisplay>(rects);
+    auto scene = std::make_shared<StubScene>();
+    auto db_compositor_factory = std::make_shared<PerOutputDisplayBufferCompositorFactory>();
+    mc::MultiThreadedCompositor compositor{
+        display, scene, db_compositor_factory, null_display_listener, null_report, default_delay, true};
+
+    auto const composited_at_least = [&](int x, int frames)
+        {
+            auto const timeout = std::chrono::steady_clock::now() + 10s;
+            while (db_compositor_factory->frames_at(x) < frames)
+            {
+                if (std::chrono::steady_clock::now() > timeout)
+                    return false;
+                scene->emit_change_event();
+            }
+            return true;
+        };
+
+    compositor.start();
+
+    for (auto x : {0, moved_from, 200})
+        ASSERT_TRUE(composited_at_least(x, frames_wanted));
+
+    mtd::StubDisplayConfig conf{*display->configuration()};
+    conf.outputs[1].top_left = {moved_to, 0};
+
+    auto groups_removed = 0;
+    ASSERT_TRUE(display->configure_changed_outputs(conf,
+        [&](mg::DisplaySyncGroup& group)
+        {
+            ++groups_removed;
+            compositor.remove_display_sync_group(group);
+
+            // While the changed output is torn down the others keep going
+            for (auto x : untouched)
+                EXPECT_TRUE(composited_at_least(x, db_compositor_factory->frames_at(x) + frames_wanted));
+        }));
+
+    compositor.add_display_sync_groups();
+
+    EXPECT_TRUE(composited_at_least(moved_to, frames_wanted));
+    EXPECT_THAT(groups_removed, Eq(1));
+
+    // No untouched output lost its compositor, so none lost any frames
+    for (auto x : untouched)
+        EXPECT_THAT(db_compositor_factory->compositors_created_at(x), Eq(1));
+
+    compositor.stop();
+}
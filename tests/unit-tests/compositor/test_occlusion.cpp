@@ -202,3 +202,34 @@ TEST_F(OcclusionFilterTest,
     EXPECT_THAT(renderables_from(occlusions), ElementsAre(partially_onscreen));
     EXPECT_THAT(renderables_from(elements), ElementsAre(covering));
 }
+
+TEST_F(OcclusionFilterTest, occludes_every_window_under_a_fullscreen_window_on_a_large_output)
+{
+    Rectangle const large_output{{0, 0}, {7680, 4320}};
+
+    std::vector<std::shared_ptr<mg::Renderable>> windows;
+    for (int i = 0; i != 500; ++i)
+        windows.push_back(std::make_shared<mtd::FakeRenderable>((i % 25) * 300, (i / 25) * 200, 400, 300));
+    auto const fullscreen = std::make_shared<mtd::FakeRenderable>(large_output);
+
+    auto elements = scene_elements_from(windows);
+    elements.push_back(std::make_shared<mtd::StubSceneElement>(fullscreen));
+
+    auto const& occlusions = filter_occlusions_from(elements, large_output);
+
+    EXPECT_THAT(renderables_from(occlusions), ContainerEq(mg::RenderableList(windows.begin(), windows.end())));
+    EXPECT_THAT(renderables_from(elements), ElementsAre(fullscreen));
+}
+
+TEST_F(OcclusionFilterTest, window_is_not_occluded_by_several_windows_that_together_cover_it)
+{
+    auto const below = std::make_shared<mtd::FakeRenderable>(900, 500, 200, 200);
+    auto const left = std::make_shared<mtd::FakeRenderable>(0, 0, 1000, 1200);
+    auto const right = std::make_shared<mtd::FakeRenderable>(1000, 0, 920, 1200);
+    auto elements = scene_elements_from({below, left, right});
+
+    auto const& occlusions = filter_occlusions_from(elements, monitor_rect);
+
+    EXPECT_THAT(renderables_from(occlusions), IsEmpty());
+    EXPECT_THAT(renderables_from(elements), ElementsAre(below, left, right));
+}
@@ -24,6 +24,7 @@
 #include "mir/test/doubles/mock_gl_buffer.h"
 #include "mir/test/doubles/stub_gl_buffer.h"
 #include "mir/test/doubles/mock_gl.h"
+#include "mir/test/doubles/mock_egl.h"
 #include "mir/test/doubles/stub_renderable.h"
 #include "mir/test/doubles/stub_display.h"
 
@@ -48,6 +49,7 @@ struct ScreencastDisplayBufferTest : testing::Test
         free_queue.schedule(mt::fake_shared(stub_buffer));
     }
 
+    testing::NiceMock<mtd::MockEGL> mock_egl;
     testing::NiceMock<mtd::MockGL> mock_gl;
     mc::QueueingSchedule free_queue;
     mc::QueueingSchedule ready_queue;
@@ -170,7 +172,27 @@ TEST_F(ScreencastDisplayBufferTest, throws_if_cannot_write_to_supplied_buffer)
     }, std::invalid_argument);
 }
 
-TEST_F(ScreencastDisplayBufferTest, forces_rendering_to_complete_on_swap)
+TEST_F(ScreencastDisplayBufferTest, waits_for_rendering_to_complete_on_swap)
+{
+    int sync;
+    ON_CALL(mock_egl, eglQueryString(_, EGL_EXTENSIONS))
+        .WillByDefault(Return("EGL_KHR_fence_sync"));
+    ON_CALL(mock_egl, eglCreateSyncKHR(_, EGL_SYNC_FENCE_KHR, _))
+        .WillByDefault(Return(&sync));
+
+    mc::ScreencastDisplayBuffer db{default_rect, default_size,
+                                   default_mirror_mode, free_queue,
+                                   ready_queue, stub_display};
+
+    Mock::VerifyAndClearExpectations(&mock_gl);
+    EXPECT_CALL(mock_gl, glFinish()).Times(0);
+    EXPECT_CALL(mock_egl, eglClientWaitSyncKHR(_, &sync, _, _));
+
+    db.bind();
+    db.swap_buffers();
+}
+
+TEST_F(ScreencastDisplayBufferTest, forces_rendering_to_complete_on_swap_without_fence_sync)
 {
     mc::ScreencastDisplayBuffer db{default_rect, default_size,
                                    default_mirror_mode, free_queue,
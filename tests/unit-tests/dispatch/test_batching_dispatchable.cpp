@@ -0,0 +1,161 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/dispatch/batching_dispatchable.h"
+#include "mir/dispatch/multiplexing_dispatchable.h"
+#include "mir/test/fd_utils.h"
+#include "mir/test/test_dispatchable.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace md = mir::dispatch;
+namespace mt = mir::test;
+
+using namespace testing;
+
+namespace
+{
+struct BatchingDispatchableTest : Test
+{
+    std::shared_ptr<md::MultiplexingDispatchable> const multiplexer{
+        std::make_shared<md::MultiplexingDispatchable>()};
+};
+}
+
+TEST_F(BatchingDispatchableTest, rejects_an_empty_batch)
+{
+    EXPECT_THROW((md::BatchingDispatchable{multiplexer, 0}), std::invalid_argument);
+}
+
+TEST_F(BatchingDispatchableTest, watches_the_multiplexer)
+{
+    md::BatchingDispatchable dispatcher{multiplexer, 2};
+
+    auto const dispatchee = std::make_shared<mt::TestDispatchable>([]{});
+    multiplexer->add_watch(dispatchee);
+    dispatchee->trigger();
+
+    EXPECT_TRUE(mt::fd_is_readable(dispatcher.watch_fd()));
+}
+
+TEST_F(BatchingDispatchableTest, dispatches_every_ready_dispatchee)
+{
+    int const dispatchee_count{5};
+    md::BatchingDispatchable dispatcher{multiplexer, dispatchee_count};
+
+    std::vector<int> dispatched;
+    std::vector<std::shared_ptr<mt::TestDispatchable>> dispatchees;
+    for (int i = 0; i != dispatchee_count; ++i)
+    {
+        dispatchees.push_back(std::make_shared<mt::TestDispatchable>([&dispatched, i]() { dispatched.push_back(i); }));
+        multiplexer->add_watch(dispatchees.back());
+        dispatchees.back()->trigger();
+    }
+
+    ASSERT_TRUE(mt::fd_is_readable(dispatcher.watch_fd()));
+    dispatcher.dispatch(md::FdEvent::readable);
+
+    EXPECT_THAT(dispatched, UnorderedElementsAre(0, 1, 2, 3, 4));
+    EXPECT_FALSE(mt::fd_is_readable(dispatcher.watch_fd()));
+}
+
+TEST_F(BatchingDispatchableTest, is_fair_to_dispatchees_that_stay_ready)
+{
+    int const dispatchee_count{4};
+    md::BatchingDispatchable dispatcher{multiplexer, 3};
+
+    std::vector<int> dispatched;
+    std::vector<std::shared_ptr<mt::TestDispatchable>> dispatchees;
+    for (int i = 0; i != dispatchee_count; ++i)
+    {
+        dispatchees.push_back(std::make_shared<mt::TestDispatchable>([&dispatched, i]() { dispatched.push_back(i); }));
+        multiplexer->add_watch(dispatchees.back());
+
+        // Each has two events pending: the dispatchees that are dispatched first stay ready
+        dispatchees.back()->trigger();
+        dispatchees.back()->trigger();
+    }
+
+    while (mt::fd_is_readable(dispatcher.watch_fd()))
+    {
+        dispatcher.dispatch(md::FdEvent::readable);
+    }
+
+    ASSERT_THAT(dispatched.size(), Eq(2u * dispatchee_count));
+
+    // No dispatchee is dispatched a second time until every one has been dispatched once
+    std::vector<int> const first_round(dispatched.begin(), dispatched.begin() + dispatchee_count);
+    EXPECT_THAT(first_round, UnorderedElementsAre(0, 1, 2, 3));
+}
+
+TEST_F(BatchingDispatchableTest, does_not_dispatch_a_dispatchee_removed_earlier_in_the_batch)
+{
+    md::BatchingDispatchable dispatcher{multiplexer, 2};
+
+    // Whichever is dispatched first removes the other, as hot-unplugging an input device does
+    std::shared_ptr<mt::TestDispatchable> first, second;
+    int dispatch_count{0};
+    first = std::make_shared<mt::TestDispatchable>(
+        [&]() { ++dispatch_count; multiplexer->remove_watch(second); });
+    second = std::make_shared<mt::TestDispatchable>(
+        [&]() { ++dispatch_count; multiplexer->remove_watch(first); });
+
+    multiplexer->add_watch(first);
+    multiplexer->add_watch(second);
+    first->trigger();
+    second->trigger();
+
+    dispatcher.dispatch(md::FdEvent::readable);
+
+    EXPECT_THAT(dispatch_count, Eq(1));
+}
+
+TEST_F(BatchingDispatchableTest, rearms_the_rest_of_the_batch_if_a_dispatchee_throws)
+{
+    md::BatchingDispatchable dispatcher{multiplexer, 2};
+
+    int dispatch_count{0};
+    bool thrown{false};
+    auto const throw_once = [&dispatch_count, &thrown]()
+        {
+            ++dispatch_count;
+            if (!thrown)
+            {
+                thrown = true;
+                throw std::runtime_error{"Dispatch failed"};
+            }
+        };
+
+    auto const first = std::make_shared<mt::TestDispatchable>(throw_once);
+    auto const second = std::make_shared<mt::TestDispatchable>(throw_once);
+    multiplexer->add_watch(first);
+    multiplexer->add_watch(second);
+    first->trigger();
+    second->trigger();
+
+    EXPECT_THROW(dispatcher.dispatch(md::FdEvent::readable), std::runtime_error);
+    EXPECT_THAT(dispatch_count, Eq(1));
+
+    // Whichever dispatchee was left over is still watched
+    ASSERT_TRUE(mt::fd_is_readable(dispatcher.watch_fd()));
+    dispatcher.dispatch(md::FdEvent::readable);
+
+    EXPECT_THAT(dispatch_count, Eq(2));
+}
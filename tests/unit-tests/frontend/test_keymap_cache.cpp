@@ -0,0 +1,111 @@
+/*
+ * Copyright © 2018 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_wayland/keymap_cache.h"
+#include "mir/input/keymap.h"
+
+#include <xkbcommon/xkbcommon.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+
+#include <unistd.h>
+
+namespace mf = mir::frontend;
+namespace mi = mir::input;
+
+using namespace testing;
+
+namespace
+{
+std::string contents_of(mir::Fd const& fd, size_t size)
+{
+    std::string result(size, '\0');
+    EXPECT_THAT(pread(fd, &result[0], size, 0), Eq(static_cast<ssize_t>(size)));
+    return result;
+}
+
+std::string text_of(mf::CompiledKeymap const& keymap)
+{
+    std::unique_ptr<char, void(*)(void*)> text{
+        xkb_keymap_get_as_string(keymap.keymap(), XKB_KEYMAP_FORMAT_TEXT_V1), free};
+    return text.get();
+}
+
+struct KeymapCache : Test
+{
+    mf::KeymapCache cache;
+    mi::Keymap const us{"pc105", "us", "", ""};
+    mi::Keymap const gb{"pc105", "gb", "", ""};
+};
+}
+
+TEST_F(KeymapCache, compiles_the_same_names_once)
+{
+    auto const first = cache.from_names(us);
+    auto const second = cache.from_names(mi::Keymap{us});
+
+    EXPECT_THAT(second, Eq(first));
+}
+
+TEST_F(KeymapCache, compiles_different_names_separately)
+{
+    auto const first = cache.from_names(us);
+    auto const second = cache.from_names(gb);
+
+    EXPECT_THAT(second, Ne(first));
+    EXPECT_THAT(text_of(*second), Ne(text_of(*first)));
+}
+
+TEST_F(KeymapCache, client_fd_holds_the_keymap_text)
+{
+    auto const keymap = cache.from_names(us);
+
+    EXPECT_THAT(contents_of(keymap->client_fd(), keymap->size()), Eq(text_of(*keymap)));
+}
+
+TEST_F(KeymapCache, clients_cannot_modify_the_keymap)
+{
+    auto const keymap = cache.from_names(us);
+    auto const fd = keymap->client_fd();
+
+    char const overwrite[] = "xkb_keymap { };";
+    if (pwrite(fd, overwrite, sizeof overwrite - 1, 0) > 0)
+    {
+        // Without sealing each client must have its own copy
+        EXPECT_THAT(contents_of(keymap->client_fd(), keymap->size()), Eq(text_of(*keymap)));
+    }
+}
+
+TEST_F(KeymapCache, compiles_the_same_buffer_once)
+{
+    auto const text = text_of(*cache.from_names(us));
+
+    auto const first = cache.from_buffer(text.data(), text.size());
+    auto const second = cache.from_buffer(std::string{text}.data(), text.size());
+
+    EXPECT_THAT(second, Eq(first));
+    EXPECT_THAT(contents_of(first->client_fd(), first->size()), Eq(text));
+}
+
+TEST_F(KeymapCache, throws_on_an_invalid_buffer)
+{
+    std::string const garbage{"this is not a keymap"};
+
+    EXPECT_THROW(cache.from_buffer(garbage.data(), garbage.size()), std::runtime_error);
+}
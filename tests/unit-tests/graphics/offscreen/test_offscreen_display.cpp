@@ -147,6 +147,45 @@ TEST_F(OffscreenDisplayTest, makes_fbo_current_rendering_target)
     });
 }
 
+TEST_F(OffscreenDisplayTest, keeps_one_frame_in_flight_on_swap)
+{
+    using namespace ::testing;
+
+    mgo::Display display{
+        native_display,
+        std::make_shared<mg::CloneDisplayConfigurationPolicy>(),
+        mr::null_display_report()};
+
+    mg::DisplayBuffer* display_buffer{nullptr};
+    display.for_each_display_sync_group([&](mg::DisplaySyncGroup& group) {
+        group.for_each_display_buffer([&](mg::DisplayBuffer& db) { display_buffer = &db; });
+    });
+    ASSERT_THAT(display_buffer, NotNull());
+
+    ON_CALL(mock_egl, eglQueryString(_, EGL_EXTENSIONS))
+        .WillByDefault(Return("EGL_KHR_fence_sync"));
+
+    int syncs[3];
+    {
+        InSequence seq;
+        EXPECT_CALL(mock_egl, eglCreateSyncKHR(_, EGL_SYNC_FENCE_KHR, _))
+            .WillOnce(Return(&syncs[0]));
+        EXPECT_CALL(mock_egl, eglCreateSyncKHR(_, EGL_SYNC_FENCE_KHR, _))
+            .WillOnce(Return(&syncs[1]));
+        EXPECT_CALL(mock_egl, eglClientWaitSyncKHR(_, &syncs[0], _, _));
+        EXPECT_CALL(mock_egl, eglCreateSyncKHR(_, EGL_SYNC_FENCE_KHR, _))
+            .WillOnce(Return(&syncs[2]));
+        EXPECT_CALL(mock_egl, eglClientWaitSyncKHR(_, &syncs[1], _, _));
+    }
+    EXPECT_CALL(mock_gl, glFinish()).Times(0);
+
+    auto const render_target = mt::as_render_target(*display_buffer);
+    render_target->make_current();
+    render_target->swap_buffers();
+    render_target->swap_buffers();
+    render_target->swap_buffers();
+}
+
 TEST_F(OffscreenDisplayTest, restores_previous_state_on_fbo_setup_failure)
 {
     using namespace ::testing;
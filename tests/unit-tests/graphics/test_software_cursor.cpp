@@ -45,6 +45,7 @@ struct MockInputScene : mtd::StubInputScene
                  void(std::weak_ptr<mg::Renderable> const&));
 
     MOCK_METHOD0(emit_scene_changed, void());
+    MOCK_METHOD1(emit_scene_damaged, void(geom::Rectangle const&));
 };
 
 struct StubCursorImage : mg::CursorImage
@@ -189,13 +190,33 @@ TEST_F(SoftwareCursor, moves_scene_renderable_offset_by_hotspot_when_moved)
                 Eq(new_position - stub_cursor_image.hotspot()));
 }
 
-TEST_F(SoftwareCursor, notifies_scene_when_moving)
+TEST_F(SoftwareCursor, notifies_scene_of_old_and_new_cursor_areas_when_moving)
 {
     using namespace testing;
 
-    EXPECT_CALL(mock_input_scene, emit_scene_changed());
+    geom::Point const new_position{22,23};
+    geom::Rectangle const old_area{geom::Point{0,0} - stub_cursor_image.hotspot(), stub_cursor_image.size()};
+    geom::Rectangle const new_area{new_position - stub_cursor_image.hotspot(), stub_cursor_image.size()};
 
     cursor.show(stub_cursor_image);
+
+    EXPECT_CALL(mock_input_scene, emit_scene_changed()).Times(0);
+    EXPECT_CALL(mock_input_scene, emit_scene_damaged(old_area));
+    EXPECT_CALL(mock_input_scene, emit_scene_damaged(new_area));
+
+    cursor.move_to(new_position);
+}
+
+TEST_F(SoftwareCursor, does_not_notify_scene_when_moving_hidden_cursor)
+{
+    using namespace testing;
+
+    cursor.show(stub_cursor_image);
+    cursor.hide();
+
+    EXPECT_CALL(mock_input_scene, emit_scene_changed()).Times(0);
+    EXPECT_CALL(mock_input_scene, emit_scene_damaged(_)).Times(0);
+
     cursor.move_to({22,23});
 }
 
@@ -283,3 +283,20 @@ TEST_F(InputEventBuilder, when_deserialized_input_device_state_event_has_supplie
         EXPECT_THAT(mir_input_device_state_event_device_pressed_keys_for_index(ids_event, 2, i), Eq(pressed_keys[i]));
     }
 }
+
+TEST_F(InputEventBuilder, serializing_into_buffer_matches_serializing_to_new_string)
+{
+    auto ev = mev::make_event(device_id, timestamp,
+        cookie, mir_keyboard_action_down, 34, 17, modifiers);
+
+    std::string buffer(4096, 'x');
+    MirEvent::serialize(ev.get(), buffer);
+
+    EXPECT_THAT(buffer, Eq(MirEvent::serialize(ev.get())));
+
+    auto const deserialized_event = MirEvent::deserialize(buffer);
+    auto const kev = mir_input_event_get_keyboard_event(mir_event_get_input_event(deserialized_event.get()));
+
+    EXPECT_THAT(mir_keyboard_event_key_code(kev), Eq(34));
+    EXPECT_THAT(mir_keyboard_event_scan_code(kev), Eq(17));
+}
@@ -34,6 +34,7 @@
 #include "mir/test/event_matchers.h"
 #include "mir/test/doubles/mock_input_dispatcher.h"
 #include "mir/test/doubles/mock_input_device_hub.h"
+#include "mir/test/doubles/advanceable_clock.h"
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
@@ -105,7 +106,7 @@ struct StubDevice : public mi::Device
 struct KeyRepeatDispatcher : public testing::Test
 {
     KeyRepeatDispatcher(bool on_arale = false)
-        : dispatcher(mock_next_dispatcher, mock_alarm_factory, cookie_authority, true, repeat_time, repeat_delay, on_arale)
+        : dispatcher(mock_next_dispatcher, mock_alarm_factory, clock, cookie_authority, true, repeat_time, repeat_delay, on_arale)
     {
         ON_CALL(hub,add_observer(_)).WillByDefault(SaveArg<0>(&observer));
         dispatcher.set_input_device_hub(mt::fake_shared(hub));
@@ -120,6 +121,7 @@ struct KeyRepeatDispatcher : public testing::Test
     const MirInputDeviceId test_device = 123;
     std::shared_ptr<mtd::MockInputDispatcher> mock_next_dispatcher = std::make_shared<mtd::MockInputDispatcher>();
     std::shared_ptr<MockAlarmFactory> mock_alarm_factory = std::make_shared<MockAlarmFactory>();
+    std::shared_ptr<mtd::AdvanceableClock> clock = std::make_shared<mtd::AdvanceableClock>();
     std::shared_ptr<mir::cookie::Authority> cookie_authority = mir::cookie::Authority::create();
     std::chrono::milliseconds const repeat_time{2};
     std::chrono::milliseconds const repeat_delay{1};
@@ -136,6 +138,21 @@ struct KeyRepeatDispatcher : public testing::Test
     {
         return mev::make_event(test_device, std::chrono::nanoseconds(0), std::vector<uint8_t>{}, mir_keyboard_action_up, 0, 0, mir_input_event_modifier_alt);
     }
+
+    mir::EventUPtr a_key_down_event(MirInputDeviceId device, int scan_code)
+    {
+        return mev::make_event(device, std::chrono::nanoseconds(0), std::vector<uint8_t>{}, mir_keyboard_action_down, 0, scan_code, mir_input_event_modifier_none);
+    }
+
+    mir::EventUPtr a_key_up_event(MirInputDeviceId device, int scan_code)
+    {
+        return mev::make_event(device, std::chrono::nanoseconds(0), std::vector<uint8_t>{}, mir_keyboard_action_up, 0, scan_code, mir_input_event_modifier_none);
+    }
+
+    void advance_clock_to(mir::time::Timestamp timeout)
+    {
+        clock->advance_by(timeout - clock->now());
+    }
 };
 
 struct KeyRepeatDispatcherOnArale : KeyRepeatDispatcher
@@ -172,20 +189,24 @@ TEST_F(KeyRepeatDispatcher, schedules_alarm_to_repeat_key_down)
 {
     MockAlarm *mock_alarm = new MockAlarm; // deleted by AlarmFactory
     std::function<void()> alarm_function;
+    mir::time::Timestamp first_repeat;
 
     InSequence seq;
     EXPECT_CALL(*mock_alarm_factory, create_alarm_adapter(_)).Times(1).
         WillOnce(DoAll(SaveArg<0>(&alarm_function), Return(mock_alarm)));
     // Once for initial down and again when invoked
-    EXPECT_CALL(*mock_alarm, reschedule_in(repeat_time)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mock_alarm, reschedule_for(_)).Times(1).WillOnce(DoAll(SaveArg<0>(&first_repeat), Return(true)));
     EXPECT_CALL(*mock_next_dispatcher, dispatch(mt::KeyDownEvent())).Times(1);
     EXPECT_CALL(*mock_next_dispatcher, dispatch(mt::KeyRepeatEvent())).Times(1);
-    EXPECT_CALL(*mock_alarm, reschedule_in(repeat_delay)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mock_alarm, reschedule_for(_)).Times(1).WillOnce(Return(true));
     EXPECT_CALL(*mock_next_dispatcher, dispatch(mt::KeyUpEvent())).Times(1);
 
+    auto const key_down_time = clock->now();
     // Schedule the repeat
     dispatcher.dispatch(a_key_down_event());
+    EXPECT_THAT(first_repeat, Eq(key_down_time + repeat_time));
     // Trigger the repeat
+    advance_clock_to(first_repeat);
     alarm_function();
     // Trigger the cancel
     dispatcher.dispatch(a_key_up_event());
@@ -195,27 +216,174 @@ TEST_F(KeyRepeatDispatcher, stops_repeat_on_device_removal)
 {
     MockAlarm *mock_alarm = new MockAlarm;
     std::function<void()> alarm_function;
+    mir::time::Timestamp first_repeat;
     bool alarm_canceled = false;
 
     InSequence seq;
     EXPECT_CALL(*mock_alarm_factory, create_alarm_adapter(_)).Times(1).
         WillOnce(DoAll(SaveArg<0>(&alarm_function), Return(mock_alarm)));
     // Once for initial down and again when invoked
-    EXPECT_CALL(*mock_alarm, reschedule_in(repeat_time)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mock_alarm, reschedule_for(_)).Times(1).WillOnce(DoAll(SaveArg<0>(&first_repeat), Return(true)));
     EXPECT_CALL(*mock_next_dispatcher, dispatch(mt::KeyDownEvent())).Times(1);
     EXPECT_CALL(*mock_next_dispatcher, dispatch(mt::KeyRepeatEvent())).Times(1);
-    EXPECT_CALL(*mock_alarm, reschedule_in(repeat_delay)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mock_alarm, reschedule_for(_)).Times(1).WillOnce(Return(true));
     ON_CALL(*mock_alarm, cancel()).WillByDefault(Invoke([&](){alarm_canceled = true; return true;}));
 
     dispatcher.dispatch(a_key_down_event());
 
+    advance_clock_to(first_repeat);
     alarm_function();
-    Mock::VerifyAndClearExpectations(mock_alarm); // mock_alarm will be deleted after this
+    Mock::VerifyAndClearExpectations(mock_alarm);
 
     simulate_device_removal();
     EXPECT_THAT(alarm_canceled, Eq(true));
 }
 
+TEST_F(KeyRepeatDispatcher, uses_one_alarm_for_all_keys_and_devices)
+{
+    auto const mock_alarm = new NiceMock<MockAlarm>;
+    MirInputDeviceId const other_device = 124;
+
+    EXPECT_CALL(*mock_alarm_factory, create_alarm_adapter(_)).Times(1).
+        WillOnce(Return(mock_alarm));
+    EXPECT_CALL(*mock_next_dispatcher, dispatch(_)).Times(AnyNumber());
+
+    dispatcher.dispatch(a_key_down_event(test_device, 30));
+    dispatcher.dispatch(a_key_down_event(test_device, 31));
+    dispatcher.dispatch(a_key_down_event(other_device, 30));
+}
+
+TEST_F(KeyRepeatDispatcher, cancels_alarm_when_last_key_is_released)
+{
+    auto const mock_alarm = new NiceMock<MockAlarm>;
+    MirInputDeviceId const other_device = 124;
+
+    EXPECT_CALL(*mock_alarm_factory, create_alarm_adapter(_)).Times(1).
+        WillOnce(Return(mock_alarm));
+    EXPECT_CALL(*mock_next_dispatcher, dispatch(_)).Times(AnyNumber());
+
+    dispatcher.dispatch(a_key_down_event(test_device, 30));
+    dispatcher.dispatch(a_key_down_event(other_device, 30));
+
+    EXPECT_CALL(*mock_alarm, cancel()).Times(0);
+    dispatcher.dispatch(a_key_up_event(test_device, 30));
+    Mock::VerifyAndClearExpectations(mock_alarm);
+
+    EXPECT_CALL(*mock_alarm, cancel()).Times(AtLeast(1));
+    dispatcher.dispatch(a_key_up_event(other_device, 30));
+    Mock::VerifyAndClearExpectations(mock_alarm);
+}
+
+TEST_F(KeyRepeatDispatcher, repeat_intervals_do_not_drift_when_the_alarm_runs_late)
+{
+    std::chrono::milliseconds const interval{20};
+    mi::KeyRepeatDispatcher dispatcher{
+        mock_next_dispatcher, mock_alarm_factory, clock, cookie_authority, true, repeat_time, interval, false};
+
+    auto const mock_alarm = new NiceMock<MockAlarm>;
+    std::function<void()> alarm_function;
+    std::vector<mir::time::Timestamp> timeouts;
+    int repeats = 0;
+
+    EXPECT_CALL(*mock_alarm_factory, create_alarm_adapter(_)).Times(1).
+        WillOnce(DoAll(SaveArg<0>(&alarm_function), Return(mock_alarm)));
+    ON_CALL(*mock_alarm, reschedule_for(_)).WillByDefault(Invoke(
+        [&](mir::time::Timestamp timeout) { timeouts.push_back(timeout); return true; }));
+    EXPECT_CALL(*mock_next_dispatcher, dispatch(mt::KeyDownEvent())).Times(1);
+    EXPECT_CALL(*mock_next_dispatcher, dispatch(mt::KeyRepeatEvent())).Times(AnyNumber()).
+        WillRepeatedly(InvokeWithoutArgs([&] { ++repeats; return true; }));
+
+    dispatcher.dispatch(a_key_down_event());
+
+    // Run each alarm late, by less than a repeat interval
+    auto const lateness = interval / 4;
+    for (int i = 0; i != 5; ++i)
+    {
+        advance_clock_to(timeouts.back() + lateness);
+        alarm_function();
+    }
+
+    EXPECT_THAT(repeats, Eq(5));
+    ASSERT_THAT(timeouts.size(), Eq(6u));
+
+    // The lateness of each alarm doesn't carry over into the next interval
+    for (size_t i = 1; i != timeouts.size(); ++i)
+        EXPECT_THAT(timeouts[i] - timeouts[i-1], Eq(interval)) << "repeat " << i;
+}
+
+TEST_F(KeyRepeatDispatcher, repeat_jitter_is_only_the_lateness_of_each_alarm)
+{
+    std::chrono::milliseconds const interval{20};
+    mi::KeyRepeatDispatcher dispatcher{
+        mock_next_dispatcher, mock_alarm_factory, clock, cookie_authority, true, repeat_time, interval, false};
+
+    auto const mock_alarm = new NiceMock<MockAlarm>;
+    std::function<void()> alarm_function;
+    std::vector<mir::time::Timestamp> timeouts;
+    std::vector<std::chrono::nanoseconds> repeat_times;
+
+    EXPECT_CALL(*mock_alarm_factory, create_alarm_adapter(_)).Times(1).
+        WillOnce(DoAll(SaveArg<0>(&alarm_function), Return(mock_alarm)));
+    ON_CALL(*mock_alarm, reschedule_for(_)).WillByDefault(Invoke(
+        [&](mir::time::Timestamp timeout) { timeouts.push_back(timeout); return true; }));
+    EXPECT_CALL(*mock_next_dispatcher, dispatch(mt::KeyDownEvent())).Times(1);
+    EXPECT_CALL(*mock_next_dispatcher, dispatch(mt::KeyRepeatEvent())).Times(AnyNumber()).
+        WillRepeatedly(Invoke([&](std::shared_ptr<MirEvent const> const& event)
+            {
+                repeat_times.push_back(event->to_input()->event_time());
+                return true;
+            }));
+
+    dispatcher.dispatch(a_key_down_event());
+
+    // Run each alarm late by an irregular amount, always less than a repeat interval
+    std::vector<std::chrono::milliseconds> const lateness{
+        std::chrono::milliseconds{0},
+        std::chrono::milliseconds{3},
+        std::chrono::milliseconds{17},
+        std::chrono::milliseconds{1},
+        std::chrono::milliseconds{9},
+        std::chrono::milliseconds{0}};
+    for (auto const late : lateness)
+    {
+        advance_clock_to(timeouts.back() + late);
+        alarm_function();
+    }
+
+    ASSERT_THAT(repeat_times.size(), Eq(lateness.size()));
+
+    // Each repeat is off its ideal time by exactly its own alarm's lateness: earlier
+    // late alarms don't accumulate into the jitter of later repeats
+    auto const first_repeat = timeouts.front().time_since_epoch();
+    for (size_t i = 0; i != repeat_times.size(); ++i)
+    {
+        auto const ideal = first_repeat + static_cast<int>(i) * interval;
+        EXPECT_THAT(repeat_times[i] - ideal, Eq(lateness[i])) << "repeat " << i;
+    }
+}
+
+TEST_F(KeyRepeatDispatcher, skips_missed_repeats_when_the_alarm_runs_more_than_an_interval_late)
+{
+    auto const mock_alarm = new NiceMock<MockAlarm>;
+    std::function<void()> alarm_function;
+    std::vector<mir::time::Timestamp> timeouts;
+
+    EXPECT_CALL(*mock_alarm_factory, create_alarm_adapter(_)).Times(1).
+        WillOnce(DoAll(SaveArg<0>(&alarm_function), Return(mock_alarm)));
+    ON_CALL(*mock_alarm, reschedule_for(_)).WillByDefault(Invoke(
+        [&](mir::time::Timestamp timeout) { timeouts.push_back(timeout); return true; }));
+    EXPECT_CALL(*mock_next_dispatcher, dispatch(mt::KeyDownEvent())).Times(1);
+    EXPECT_CALL(*mock_next_dispatcher, dispatch(mt::KeyRepeatEvent())).Times(1);
+
+    dispatcher.dispatch(a_key_down_event());
+
+    advance_clock_to(timeouts.back() + 10*repeat_delay);
+    alarm_function();
+
+    ASSERT_THAT(timeouts.size(), Eq(2u));
+    EXPECT_THAT(timeouts.back(), Eq(clock->now() + repeat_delay));
+}
+
 TEST_F(KeyRepeatDispatcherOnArale, no_repeat_alarm_on_mtk_tpd)
 {
     EXPECT_CALL(*mock_alarm_factory, create_alarm_adapter(_)).Times(0);
@@ -230,16 +398,19 @@ TEST_F(KeyRepeatDispatcherOnArale, repeat_for_regular_keys)
 {
     MockAlarm *mock_alarm = new MockAlarm;
     std::function<void()> alarm_function;
+    mir::time::Timestamp first_repeat;
 
     EXPECT_CALL(*mock_alarm_factory, create_alarm_adapter(_)).Times(1).
         WillOnce(DoAll(SaveArg<0>(&alarm_function), Return(mock_alarm)));
     // Once for initial down and again when invoked
-    EXPECT_CALL(*mock_alarm, reschedule_in(repeat_delay)).Times(1).WillOnce(Return(true));
-    EXPECT_CALL(*mock_alarm, reschedule_in(repeat_time)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*mock_alarm, reschedule_for(_)).Times(2).
+        WillOnce(DoAll(SaveArg<0>(&first_repeat), Return(true))).
+        WillOnce(Return(true));
     EXPECT_CALL(*mock_next_dispatcher, dispatch(mt::KeyDownEvent())).Times(1);
     EXPECT_CALL(*mock_next_dispatcher, dispatch(mt::KeyRepeatEvent())).Times(1);
 
     add_mtk_tpd();
     dispatcher.dispatch(a_key_down_event());
+    advance_clock_to(first_repeat);
     alarm_function();
 }
@@ -24,6 +24,7 @@
 #include "mir/graphics/graphic_buffer_allocator.h"
 #include "src/platforms/mesa/server/buffer_allocator.h"
 #include "mir/graphics/buffer_properties.h"
+#include "mir/renderer/gl/texture_source.h"
 
 #include "mir/test/doubles/mock_drm.h"
 #include "mir/test/doubles/mock_gbm.h"
@@ -40,6 +41,10 @@
 #include <gmock/gmock.h>
 
 #include <gbm.h>
+#include <wayland-server.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
 
 namespace mg = mir::graphics;
 namespace mgm = mir::graphics::mesa;
@@ -68,7 +73,8 @@ protected:
                 mir::report::null_display_report(),
                 std::make_shared<mtd::StubConsoleServices>(),
                 *std::make_shared<mtd::NullEmergencyCleanup>(),
-                mgm::BypassOption::allowed);
+                mgm::BypassOption::allowed,
+                mgm::PartialReconfigurationOption::prohibited);
         allocator.reset(new mgm::BufferAllocator(
             platform->gbm->device, mgm::BypassOption::allowed, mgm::BufferImportMethod::gbm_native_pixmap));
     }
@@ -321,3 +327,113 @@ TEST_F(MesaBufferAllocatorTest, screencast_can_create_buffer)
                                  mg::BufferUsage::hardware});
     });
 }
+
+namespace
+{
+class MesaWaylandBufferTest : public MesaBufferAllocatorTest
+{
+protected:
+    void SetUp() override
+    {
+        using namespace testing;
+
+        MesaBufferAllocatorTest::SetUp();
+
+        ON_CALL(mock_egl, eglBindWaylandDisplayWL(_,_))
+            .WillByDefault(Return(EGL_TRUE));
+        ON_CALL(mock_egl, eglQueryWaylandBufferWL(_,_,_,_))
+            .WillByDefault(Return(EGL_TRUE));
+        ON_CALL(mock_egl, eglQueryWaylandBufferWL(_,_,EGL_TEXTURE_FORMAT,_))
+            .WillByDefault(DoAll(SetArgPointee<3>(EGL_TEXTURE_RGBA), Return(EGL_TRUE)));
+
+        allocator->bind_display(display);
+
+        int fds[2];
+        ASSERT_THAT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds), Eq(0));
+        client_fd = fds[1];
+        client = wl_client_create(display, fds[0]);
+        buffer_resource = wl_resource_create(client, &wl_buffer_interface, 1, 0);
+    }
+
+    void TearDown() override
+    {
+        if (buffer_resource)
+            wl_resource_destroy(buffer_resource);
+        if (client)
+            wl_client_destroy(client);
+        if (client_fd >= 0)
+            close(client_fd);
+        wl_display_destroy(display);
+    }
+
+    std::shared_ptr<mg::Buffer> import_wl_buffer()
+    {
+        return allocator->buffer_from_resource(buffer_resource, []{}, []{});
+    }
+
+    static void bind(std::shared_ptr<mg::Buffer> const& buffer)
+    {
+        dynamic_cast<mir::renderer::gl::TextureSource*>(buffer->native_buffer_base())->gl_bind_to_texture();
+    }
+
+    void destroy_wl_buffer()
+    {
+        wl_resource_destroy(buffer_resource);
+        buffer_resource = nullptr;
+    }
+
+    wl_display* const display{wl_display_create()};
+    wl_client* client{nullptr};
+    int client_fd{-1};
+    wl_resource* buffer_resource{nullptr};
+};
+}
+
+TEST_F(MesaWaylandBufferTest, reimporting_a_wl_buffer_reuses_its_egl_image)
+{
+    using namespace testing;
+
+    EXPECT_CALL(mock_egl, eglCreateImageKHR(_,_,EGL_WAYLAND_BUFFER_WL,buffer_resource,_)).Times(1);
+
+    auto buffer = import_wl_buffer();
+    bind(buffer);
+    bind(buffer);
+    buffer.reset();
+
+    buffer = import_wl_buffer();
+    bind(buffer);
+}
+
+TEST_F(MesaWaylandBufferTest, egl_image_is_released_when_the_wl_buffer_goes_after_the_last_wrapper)
+{
+    using namespace testing;
+
+    EXPECT_CALL(mock_egl, eglCreateImageKHR(_,_,EGL_WAYLAND_BUFFER_WL,buffer_resource,_)).Times(1);
+    EXPECT_CALL(mock_egl, eglDestroyImageKHR(_,mock_egl.fake_egl_image)).Times(0);
+
+    auto buffer = import_wl_buffer();
+    bind(buffer);
+    buffer.reset();
+
+    Mock::VerifyAndClearExpectations(&mock_egl);
+    EXPECT_CALL(mock_egl, eglDestroyImageKHR(_,mock_egl.fake_egl_image)).Times(1);
+
+    destroy_wl_buffer();
+}
+
+TEST_F(MesaWaylandBufferTest, egl_image_is_released_when_the_last_wrapper_goes_after_the_wl_buffer)
+{
+    using namespace testing;
+
+    EXPECT_CALL(mock_egl, eglCreateImageKHR(_,_,EGL_WAYLAND_BUFFER_WL,buffer_resource,_)).Times(1);
+    EXPECT_CALL(mock_egl, eglDestroyImageKHR(_,mock_egl.fake_egl_image)).Times(0);
+
+    auto buffer = import_wl_buffer();
+    bind(buffer);
+    destroy_wl_buffer();
+
+    Mock::VerifyAndClearExpectations(&mock_egl);
+    EXPECT_CALL(mock_egl, eglDestroyImageKHR(_,mock_egl.fake_egl_image)).Times(1);
+
+    buffer.reset();
+}
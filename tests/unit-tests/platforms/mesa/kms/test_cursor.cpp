@@ -413,6 +413,37 @@ TEST_F(MesaCursorTest, show_cursor_writes_to_bo)
     cursor.show(image);
 }
 
+TEST_F(MesaCursorTest, showing_the_same_image_again_does_not_rewrite_bo)
+{
+    using namespace testing;
+
+    int writes{0};
+    ON_CALL(mock_gbm, gbm_bo_write(_, _, _))
+        .WillByDefault(InvokeWithoutArgs([&writes] { ++writes; return 0; }));
+
+    cursor.show(stub_image);
+    auto const writes_after_first_show = writes;
+    cursor.show(stub_image);
+
+    EXPECT_THAT(writes_after_first_show, Gt(0));
+    EXPECT_THAT(writes, Eq(writes_after_first_show));
+}
+
+TEST_F(MesaCursorTest, showing_a_different_image_rewrites_bo)
+{
+    using namespace testing;
+
+    int writes{0};
+    ON_CALL(mock_gbm, gbm_bo_write(_, _, _))
+        .WillByDefault(InvokeWithoutArgs([&writes] { ++writes; return 0; }));
+
+    cursor.show(stub_image);
+    auto const writes_after_first_show = writes;
+    cursor.show(SinglePixelCursorImage());
+
+    EXPECT_THAT(writes, Gt(writes_after_first_show));
+}
+
 // When we upload our 1x1 cursor we should upload a single white pixel and then transparency filling a 64x64 buffer.
 MATCHER_P(ContainsASingleWhitePixel, buffersize, "")
 {
@@ -465,6 +496,35 @@ TEST_F(MesaCursorTest, pads_missing_data_when_buffer_size_differs)
     cursor_tmp.show(SinglePixelCursorImage());
 }
 
+TEST_F(MesaCursorTest, writes_an_earlier_image_again_after_showing_many_others)
+{
+    using namespace testing;
+
+    struct OnePixelCursorImage : public StubCursorImage
+    {
+        explicit OnePixelCursorImage(uint32_t pixel) : pixel{pixel} {}
+        geom::Size size() const override { return {1, 1}; }
+        void const* as_argb_8888() const override { return &pixel; }
+
+        uint32_t const pixel;
+    };
+
+    size_t const height = 64;
+    size_t const width = 64;
+    size_t const stride = width * 4;
+    size_t const buffer_size_bytes{height * stride};
+    ON_CALL(mock_gbm, gbm_bo_get_stride(_))
+        .WillByDefault(Return(stride));
+
+    cursor.show(SinglePixelCursorImage());
+    // More distinct images than the cursor keeps prepared
+    for (uint32_t pixel = 1; pixel != 200; ++pixel)
+        cursor.show(OnePixelCursorImage{pixel});
+
+    EXPECT_CALL(mock_gbm, gbm_bo_write(mock_gbm.fake_gbm.bo, ContainsASingleWhitePixel(width*height), buffer_size_bytes));
+    cursor.show(SinglePixelCursorImage());
+}
+
 TEST_F(MesaCursorTest, does_not_throw_when_images_are_too_large)
 {
     using namespace testing;
@@ -121,7 +121,8 @@ public:
                mir::report::null_display_report(),
                std::make_shared<mtd::StubConsoleServices>(),
                *std::make_shared<mtd::NullEmergencyCleanup>(),
-               mgm::BypassOption::allowed);
+               mgm::BypassOption::allowed,
+               mgm::PartialReconfigurationOption::prohibited);
     }
 
     std::shared_ptr<mgm::Display> create_display(
@@ -132,6 +133,7 @@ public:
             platform->gbm,
             platform->vt,
             platform->bypass_option(),
+            platform->partial_reconfiguration_option(),
             std::make_shared<mg::CloneDisplayConfigurationPolicy>(),
             std::make_shared<mtd::StubGLConfig>(),
             null_report);
@@ -549,6 +551,7 @@ TEST_F(MesaDisplayTest, successful_creation_of_display_reports_successful_setup_
                         platform->gbm,
                         platform->vt,
                         platform->bypass_option(),
+                        platform->partial_reconfiguration_option(),
                         std::make_shared<mg::CloneDisplayConfigurationPolicy>(),
                         std::make_shared<mtd::StubGLConfig>(),
                         mock_report);
@@ -760,6 +763,7 @@ TEST_F(MesaDisplayTest, respects_gl_config)
         platform->gbm,
         platform->vt,
         platform->bypass_option(),
+        platform->partial_reconfiguration_option(),
         std::make_shared<mg::CloneDisplayConfigurationPolicy>(),
         mir::test::fake_shared(mock_gl_config),
         null_report};
@@ -797,6 +801,7 @@ TEST_F(MesaDisplayTest, DISABLED_supports_as_low_as_15bit_colour)
         platform->gbm,
         platform->vt,
         platform->bypass_option(),
+        platform->partial_reconfiguration_option(),
         std::make_shared<mg::CloneDisplayConfigurationPolicy>(),
         mir::test::fake_shared(stub_gl_config),
         null_report};
@@ -130,7 +130,8 @@ public:
                mir::report::null_display_report(),
                std::make_shared<mtd::StubConsoleServices>(),
                *std::make_shared<mtd::NullEmergencyCleanup>(),
-               mgm::BypassOption::allowed);
+               mgm::BypassOption::allowed,
+               mgm::PartialReconfigurationOption::prohibited);
     }
 
     std::shared_ptr<mg::Display> create_display(
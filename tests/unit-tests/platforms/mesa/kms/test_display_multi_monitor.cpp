@@ -146,13 +146,16 @@ public:
         mock_drm.reset("/dev/dri/card2");
     }
 
-    std::shared_ptr<mgm::Platform> create_platform()
+    std::shared_ptr<mgm::Platform> create_platform(
+        mgm::PartialReconfigurationOption partial_reconfiguration_option =
+            mgm::PartialReconfigurationOption::prohibited)
     {
         return std::make_shared<mgm::Platform>(
                mir::report::null_display_report(),
                std::make_shared<mtd::StubConsoleServices>(),
                *std::make_shared<mtd::NullEmergencyCleanup>(),
-               mgm::BypassOption::allowed);
+               mgm::BypassOption::allowed,
+               partial_reconfiguration_option);
     }
 
     std::shared_ptr<mg::Display> create_display_cloned(
@@ -594,3 +597,78 @@ TEST_F(MesaDisplayMultiMonitorTest, resume_clears_unused_connected_outputs)
                         .Times(1);
     }
 }
+
+TEST_F(MesaDisplayMultiMonitorTest, configure_changed_outputs_replaces_only_changed_groups)
+{
+    using namespace testing;
+
+    int const num_connected_outputs{3};
+    int const num_disconnected_outputs{2};
+
+    setup_outputs(num_connected_outputs, num_disconnected_outputs);
+
+    auto display = create_display_side_by_side(
+        create_platform(mgm::PartialReconfigurationOption::allowed));
+
+    std::vector<mg::DisplaySyncGroup*> groups_before;
+    display->for_each_display_sync_group(
+        [&](mg::DisplaySyncGroup& group) { groups_before.push_back(&group); });
+    ASSERT_THAT(groups_before.size(), Eq(3u));
+
+    /* Change the mode of the last output only */
+    auto conf = display->configuration();
+    conf->for_each_output(
+        [&](mg::UserDisplayConfigurationOutput& output)
+        {
+            if (output.connected && output.top_left.x.as_int() >= 2 * 1920)
+                output.current_mode_index = 2;
+        });
+
+    std::vector<mg::DisplaySyncGroup*> removed;
+    EXPECT_TRUE(display->configure_changed_outputs(*conf,
+        [&](mg::DisplaySyncGroup& group) { removed.push_back(&group); }));
+
+    std::vector<mg::DisplaySyncGroup*> groups_after;
+    display->for_each_display_sync_group(
+        [&](mg::DisplaySyncGroup& group) { groups_after.push_back(&group); });
+
+    EXPECT_THAT(removed, ElementsAre(groups_before[2]));
+    ASSERT_THAT(groups_after.size(), Eq(3u));
+    EXPECT_THAT(groups_after[0], Eq(groups_before[0]));
+    EXPECT_THAT(groups_after[1], Eq(groups_before[1]));
+}
+
+TEST_F(MesaDisplayMultiMonitorTest, configure_changed_outputs_declines_unless_allowed)
+{
+    using namespace testing;
+
+    int const num_connected_outputs{3};
+    int const num_disconnected_outputs{2};
+
+    setup_outputs(num_connected_outputs, num_disconnected_outputs);
+
+    auto display = create_display_side_by_side(create_platform());
+
+    std::vector<mg::DisplaySyncGroup*> groups_before;
+    display->for_each_display_sync_group(
+        [&](mg::DisplaySyncGroup& group) { groups_before.push_back(&group); });
+
+    auto conf = display->configuration();
+    conf->for_each_output(
+        [&](mg::UserDisplayConfigurationOutput& output)
+        {
+            if (output.connected && output.top_left.x.as_int() >= 2 * 1920)
+                output.current_mode_index = 2;
+        });
+
+    std::vector<mg::DisplaySyncGroup*> removed;
+    EXPECT_FALSE(display->configure_changed_outputs(*conf,
+        [&](mg::DisplaySyncGroup& group) { removed.push_back(&group); }));
+
+    std::vector<mg::DisplaySyncGroup*> groups_after;
+    display->for_each_display_sync_group(
+        [&](mg::DisplaySyncGroup& group) { groups_after.push_back(&group); });
+
+    EXPECT_THAT(removed, IsEmpty());
+    EXPECT_THAT(groups_after, ContainerEq(groups_before));
+}
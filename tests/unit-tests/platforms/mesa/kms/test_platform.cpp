@@ -92,7 +92,8 @@ public:
                 mir::report::null_display_report(),
                 std::make_shared<mtd::StubConsoleServices>(),
                 *std::make_shared<mtd::NullEmergencyCleanup>(),
-                mgm::BypassOption::allowed);
+                mgm::BypassOption::allowed,
+                mgm::PartialReconfigurationOption::prohibited);
     }
 
     EGLDisplay fake_display{reinterpret_cast<EGLDisplay>(0xabcd)};
@@ -0,0 +1,216 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/renderers/gl/program_binary_cache.h"
+
+#include "mir/test/doubles/mock_gl.h"
+#include "mir/test/doubles/mock_egl.h"
+#include "mir_test_framework/temporary_environment_value.h"
+
+#include <boost/filesystem.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <system_error>
+
+namespace mtd = mir::test::doubles;
+namespace mrg = mir::renderer::gl;
+namespace mtf = mir_test_framework;
+
+using namespace testing;
+
+namespace
+{
+GLenum const program_binary_length = 0x8741;
+GLenum const num_program_binary_formats = 0x87FE;
+GLenum const binary_format = 0x1234;
+
+char const* const vshader = "vertex shader source";
+char const* const fshader = "fragment shader source";
+char const* const other_fshader = "other fragment shader source";
+
+// What the fake driver has "linked", and what it has been asked to load
+std::map<GLuint, std::string> linked_binaries;
+std::map<GLuint, std::string> loaded_binaries;
+
+void fake_glGetProgramBinary(GLuint program, GLsizei size, GLsizei* length, GLenum* format, void* binary)
+{
+    auto const& data = linked_binaries[program];
+    auto const written = std::min<GLsizei>(size, data.size());
+    memcpy(binary, data.data(), written);
+    *length = written;
+    *format = binary_format;
+}
+
+void fake_glProgramBinary(GLuint program, GLenum format, void const* binary, GLint length)
+{
+    if (format == binary_format)
+        loaded_binaries[program].assign(static_cast<char const*>(binary), length);
+}
+
+struct ProgramBinaryCache : Test
+{
+    ProgramBinaryCache()
+    {
+        char name[] = "/tmp/mir_program_binary_cache_XXXXXX";
+        if (mkdtemp(name) == NULL)
+            throw std::system_error{errno, std::system_category(), "Failed to create temporary directory"};
+        directory = name;
+
+        linked_binaries.clear();
+        loaded_binaries.clear();
+
+        ON_CALL(mock_gl, glGetString(GL_EXTENSIONS))
+            .WillByDefault(Return(reinterpret_cast<GLubyte const*>("GL_OES_get_program_binary")));
+        ON_CALL(mock_gl, glGetString(GL_RENDERER))
+            .WillByDefault(Return(reinterpret_cast<GLubyte const*>("Fake renderer")));
+        ON_CALL(mock_gl, glGetIntegerv(num_program_binary_formats, _))
+            .WillByDefault(SetArgPointee<1>(1));
+        ON_CALL(mock_gl, glGetProgramiv(_, program_binary_length, _))
+            .WillByDefault(Invoke([](GLuint program, GLenum, GLint* length)
+                { *length = linked_binaries[program].size(); }));
+        ON_CALL(mock_gl, glGetProgramiv(_, GL_LINK_STATUS, _))
+            .WillByDefault(Invoke([](GLuint program, GLenum, GLint* status)
+                { *status = loaded_binaries.count(program) ? GL_TRUE : GL_FALSE; }));
+
+        typedef mtd::MockEGL::generic_function_pointer_t func_ptr_t;
+        ON_CALL(mock_egl, eglGetProcAddress(StrEq("glGetProgramBinaryOES")))
+            .WillByDefault(Return(reinterpret_cast<func_ptr_t>(&fake_glGetProgramBinary)));
+        ON_CALL(mock_egl, eglGetProcAddress(StrEq("glProgramBinaryOES")))
+            .WillByDefault(Return(reinterpret_cast<func_ptr_t>(&fake_glProgramBinary)));
+    }
+
+    ~ProgramBinaryCache()
+    {
+        boost::system::error_code ignored;
+        boost::filesystem::remove_all(directory, ignored);
+    }
+
+    size_t cached_entries() const
+    {
+        size_t count = 0;
+        for (boost::filesystem::directory_iterator i{directory}, end; i != end; ++i)
+            ++count;
+        return count;
+    }
+
+    NiceMock<mtd::MockGL> mock_gl;
+    NiceMock<mtd::MockEGL> mock_egl;
+    std::string directory;
+
+    GLuint const first_program{1};
+    GLuint const second_program{2};
+};
+}
+
+TEST_F(ProgramBinaryCache, loads_nothing_from_an_empty_cache)
+{
+    mrg::ProgramBinaryCache cache{directory};
+
+    EXPECT_FALSE(cache.load(first_program, vshader, fshader));
+}
+
+TEST_F(ProgramBinaryCache, reloads_a_stored_program_in_a_new_cache)
+{
+    linked_binaries[first_program] = "linked program";
+
+    mrg::ProgramBinaryCache{directory}.store(first_program, vshader, fshader);
+
+    mrg::ProgramBinaryCache cache{directory};
+    EXPECT_TRUE(cache.load(second_program, vshader, fshader));
+    EXPECT_THAT(loaded_binaries[second_program], Eq("linked program"));
+}
+
+TEST_F(ProgramBinaryCache, caches_in_the_directory_given_by_the_environment)
+{
+    mtf::TemporaryEnvironmentValue cache_dir{"MIR_SHADER_CACHE_DIR", directory.c_str()};
+    linked_binaries[first_program] = "linked program";
+
+    mrg::ProgramBinaryCache{}.store(first_program, vshader, fshader);
+
+    EXPECT_THAT(cached_entries(), Eq(1u));
+    EXPECT_TRUE(mrg::ProgramBinaryCache{directory}.load(second_program, vshader, fshader));
+}
+
+TEST_F(ProgramBinaryCache, is_disabled_by_an_empty_directory_in_the_environment)
+{
+    mtf::TemporaryEnvironmentValue cache_dir{"MIR_SHADER_CACHE_DIR", ""};
+    mtf::TemporaryEnvironmentValue cache_home{"XDG_CACHE_HOME", directory.c_str()};
+    linked_binaries[first_program] = "linked program";
+
+    mrg::ProgramBinaryCache cache;
+    cache.store(first_program, vshader, fshader);
+
+    EXPECT_THAT(cached_entries(), Eq(0u));
+    EXPECT_FALSE(cache.load(second_program, vshader, fshader));
+}
+
+TEST_F(ProgramBinaryCache, does_not_load_a_program_built_from_other_sources)
+{
+    linked_binaries[first_program] = "linked program";
+
+    mrg::ProgramBinaryCache{directory}.store(first_program, vshader, fshader);
+
+    mrg::ProgramBinaryCache cache{directory};
+    EXPECT_FALSE(cache.load(second_program, vshader, other_fshader));
+}
+
+TEST_F(ProgramBinaryCache, does_not_load_a_program_built_by_another_driver)
+{
+    linked_binaries[first_program] = "linked program";
+
+    mrg::ProgramBinaryCache{directory}.store(first_program, vshader, fshader);
+
+    ON_CALL(mock_gl, glGetString(GL_RENDERER))
+        .WillByDefault(Return(reinterpret_cast<GLubyte const*>("Another renderer")));
+
+    mrg::ProgramBinaryCache cache{directory};
+    EXPECT_FALSE(cache.load(second_program, vshader, fshader));
+}
+
+TEST_F(ProgramBinaryCache, discards_a_binary_the_driver_rejects)
+{
+    linked_binaries[first_program] = "linked program";
+
+    mrg::ProgramBinaryCache{directory}.store(first_program, vshader, fshader);
+    ASSERT_THAT(cached_entries(), Eq(1u));
+
+    EXPECT_CALL(mock_gl, glGetProgramiv(second_program, GL_LINK_STATUS, _))
+        .WillOnce(SetArgPointee<2>(GL_FALSE));
+
+    mrg::ProgramBinaryCache cache{directory};
+    EXPECT_FALSE(cache.load(second_program, vshader, fshader));
+    EXPECT_THAT(cached_entries(), Eq(0u));
+}
+
+TEST_F(ProgramBinaryCache, does_nothing_without_driver_support)
+{
+    ON_CALL(mock_gl, glGetString(GL_EXTENSIONS))
+        .WillByDefault(Return(reinterpret_cast<GLubyte const*>("GL_OES_EGL_image")));
+    linked_binaries[first_program] = "linked program";
+
+    mrg::ProgramBinaryCache cache{directory};
+    cache.store(first_program, vshader, fshader);
+
+    EXPECT_FALSE(cache.load(second_program, vshader, fshader));
+    EXPECT_THAT(cached_entries(), Eq(0u));
+}
@@ -35,6 +35,7 @@
 #include "src/server/report/null_report_factory.h"
 
 #include <algorithm>
+#include <atomic>
 #include <future>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
@@ -164,6 +165,29 @@ TEST_F(BasicSurfaceTest, update_top_left)
     EXPECT_EQ(new_top_left, surface.top_left());
 }
 
+TEST_F(BasicSurfaceTest, reads_consistent_state_while_moved_concurrently)
+{
+    surface.move_to({0, 0});
+
+    std::atomic<bool> done{false};
+    auto mover = std::async(std::launch::async, [&]
+        {
+            for (int i = 0; i != 10000; ++i)
+                surface.move_to({i, i});
+            done = true;
+        });
+
+    while (!done)
+    {
+        auto const bounds = surface.input_bounds();
+        EXPECT_THAT(bounds.top_left.x.as_int(), testing::Eq(bounds.top_left.y.as_int()));
+        EXPECT_THAT(bounds.size, testing::Eq(rect.size));
+    }
+
+    mover.wait();
+    EXPECT_THAT(surface.top_left(), testing::Eq(geom::Point{9999, 9999}));
+}
+
 TEST_F(BasicSurfaceTest, update_size)
 {
     geom::Size const new_size{34, 56};
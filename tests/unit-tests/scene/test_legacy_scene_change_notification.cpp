@@ -39,6 +39,10 @@ struct MockBufferCallback
 {
     MOCK_METHOD1(invoke, void(int));
 };
+struct MockDamageCallback
+{
+    MOCK_METHOD2(invoke, void(int, mir::geometry::Rectangle const&));
+};
 
 struct LegacySceneChangeNotificationTest : public testing::Test
 {
@@ -64,6 +68,29 @@ TEST_F(LegacySceneChangeNotificationTest, fowards_all_observations_to_callback)
     observer.surfaces_reordered();
 }
 
+TEST_F(LegacySceneChangeNotificationTest, forwards_scene_damage_to_damage_callback)
+{
+    using namespace ::testing;
+    mir::geometry::Rectangle const damage{{10, 20}, {30, 40}};
+    NiceMock<MockDamageCallback> damage_callback;
+
+    EXPECT_CALL(scene_callback, invoke()).Times(0);
+    EXPECT_CALL(damage_callback, invoke(1, damage)).Times(1);
+
+    ms::LegacySceneChangeNotification observer(
+        scene_change_callback,
+        [&](int frames, mir::geometry::Rectangle const& damage){ damage_callback.invoke(frames, damage); });
+    observer.scene_damaged(damage);
+}
+
+TEST_F(LegacySceneChangeNotificationTest, forwards_scene_damage_as_scene_change_without_damage_callback)
+{
+    EXPECT_CALL(scene_callback, invoke()).Times(1);
+
+    ms::LegacySceneChangeNotification observer(scene_change_callback, buffer_change_callback);
+    observer.scene_damaged({{10, 20}, {30, 40}});
+}
+
 TEST_F(LegacySceneChangeNotificationTest, registers_observer_with_surfaces)
 {
     EXPECT_CALL(surface, add_observer(testing::_))
@@ -26,6 +26,7 @@
 
 #include "mir/test/doubles/mock_display.h"
 #include "mir/test/doubles/mock_compositor.h"
+#include "mir/test/doubles/null_display_sync_group.h"
 #include "mir/test/doubles/null_display_configuration.h"
 #include "mir/test/doubles/stub_display_configuration.h"
 #include "mir/test/doubles/mock_scene_session.h"
@@ -218,6 +219,75 @@ TEST_F(MediatingDisplayChangerTest, does_not_pause_system_when_applying_new_conf
                        mt::fake_shared(conf));
 }
 
+TEST_F(MediatingDisplayChangerTest, only_replaces_changed_outputs_when_display_supports_it)
+{
+    using namespace testing;
+    mtd::NullDisplayConfiguration conf;
+    mtd::StubDisplaySyncGroup changed_group{geom::Size{100, 100}};
+    auto session = std::make_shared<mtd::StubSession>();
+
+    ON_CALL(mock_display, apply_if_configuration_preserves_display_buffers(_))
+        .WillByDefault(Return(false));
+
+    InSequence s;
+    EXPECT_CALL(mock_display, configure_changed_outputs(Ref(conf), _))
+        .WillOnce(DoAll(
+            WithArg<1>(Invoke([&](std::function<void(mg::DisplaySyncGroup&)> const& removing_group)
+                { removing_group(changed_group); })),
+            Return(true)));
+    EXPECT_CALL(mock_compositor, remove_display_sync_group(Ref(changed_group)));
+    EXPECT_CALL(mock_compositor, add_display_sync_groups());
+
+    EXPECT_CALL(mock_compositor, stop()).Times(0);
+    EXPECT_CALL(mock_compositor, start()).Times(0);
+    EXPECT_CALL(mock_display, configure(_)).Times(0);
+
+    session_event_sink.handle_focus_change(session);
+    changer->configure(session,
+                       mt::fake_shared(conf));
+}
+
+TEST_F(MediatingDisplayChangerTest, does_not_touch_display_when_focused_session_configuration_matches_current)
+{
+    using namespace testing;
+    std::shared_ptr<mg::DisplayConfiguration> const conf{mock_display.configuration()};
+    auto session = std::make_shared<mtd::StubSession>();
+
+    EXPECT_CALL(mock_display, apply_if_configuration_preserves_display_buffers(_)).Times(0);
+    EXPECT_CALL(mock_display, configure_changed_outputs(_, _)).Times(0);
+    EXPECT_CALL(mock_display, configure(_)).Times(0);
+    EXPECT_CALL(mock_compositor, stop()).Times(0);
+
+    session_event_sink.handle_focus_change(session);
+    changer->configure(session, conf);
+
+    session_event_sink.handle_no_focus();
+    session_event_sink.handle_focus_change(session);
+}
+
+TEST_F(MediatingDisplayChangerTest, switching_focus_to_a_rotated_configuration_keeps_display_buffers)
+{
+    using namespace testing;
+    std::shared_ptr<mg::DisplayConfiguration> const conf{mock_display.configuration()};
+    conf->for_each_output([](mg::UserDisplayConfigurationOutput& output)
+        {
+            output.orientation = mir_orientation_left;
+        });
+    auto focused = std::make_shared<mtd::StubSession>();
+    auto rotated = std::make_shared<mtd::StubSession>();
+
+    session_event_sink.handle_focus_change(focused);
+    changer->configure(rotated, conf);
+
+    EXPECT_CALL(mock_display, apply_if_configuration_preserves_display_buffers(Ref(*conf)))
+        .WillOnce(Return(true));
+    EXPECT_CALL(mock_display, configure_changed_outputs(_, _)).Times(0);
+    EXPECT_CALL(mock_display, configure(_)).Times(0);
+    EXPECT_CALL(mock_compositor, stop()).Times(0);
+
+    session_event_sink.handle_focus_change(rotated);
+}
+
 TEST_F(MediatingDisplayChangerTest, sends_error_when_applying_new_configuration_for_focused_session_fails)
 {
     using namespace testing;
@@ -79,6 +79,7 @@ struct MockSceneObserver : public ms::Observer
     MOCK_METHOD1(surface_removed, void(ms::Surface*));
     MOCK_METHOD0(surfaces_reordered, void());
     MOCK_METHOD0(scene_changed, void());
+    MOCK_METHOD1(scene_damaged, void(geom::Rectangle const&));
 
     MOCK_METHOD1(surface_exists, void(ms::Surface*));
     MOCK_METHOD0(end_observation, void());
@@ -919,6 +920,25 @@ TEST_F(SurfaceStack, scene_observers_notified_of_generic_scene_change)
     stack.emit_scene_changed();
 }
 
+TEST_F(SurfaceStack, scene_observers_without_damage_handling_treat_damage_as_scene_change)
+{
+    struct SceneChangeObserver : ms::Observer
+    {
+        MOCK_METHOD1(surface_added, void(ms::Surface*));
+        MOCK_METHOD1(surface_removed, void(ms::Surface*));
+        MOCK_METHOD0(surfaces_reordered, void());
+        MOCK_METHOD0(scene_changed, void());
+        MOCK_METHOD1(surface_exists, void(ms::Surface*));
+        MOCK_METHOD0(end_observation, void());
+    } observer;
+
+    EXPECT_CALL(observer, scene_changed()).Times(1);
+
+    stack.add_observer(mt::fake_shared(observer));
+
+    stack.emit_scene_damaged({{10, 20}, {30, 40}});
+}
+
 TEST_F(SurfaceStack, for_each_enumerates_all_input_surfaces)
 {
     using namespace ::testing;
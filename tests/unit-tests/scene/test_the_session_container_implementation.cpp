@@ -85,3 +85,53 @@ TEST(DefaultSessionContainer, invalid_session_throw_behavior)
         container.remove_session(std::make_shared<mtd::StubSession>());
     }, std::logic_error);
 }
+
+TEST(DefaultSessionContainer, successor_of_skips_removed_sessions)
+{
+    using namespace ::testing;
+    ms::DefaultSessionContainer container;
+
+    auto session1 = std::make_shared<mtd::StubSession>();
+    auto session2 = std::make_shared<mtd::StubSession>();
+    auto session3 = std::make_shared<mtd::StubSession>();
+
+    container.insert_session(session1);
+    container.insert_session(session2);
+    container.insert_session(session3);
+    container.remove_session(session2);
+
+    EXPECT_EQ(session3, container.successor_of(session1));
+    EXPECT_EQ(session1, container.successor_of(session3));
+
+    container.remove_session(session3);
+
+    EXPECT_EQ(session1, container.successor_of(session1));
+    EXPECT_EQ(session1, container.successor_of(std::shared_ptr<ms::Session>()));
+}
+
+TEST(DefaultSessionContainer, successor_of_invalid_session_throws)
+{
+    using namespace ::testing;
+    ms::DefaultSessionContainer container;
+
+    auto session = std::make_shared<mtd::StubSession>();
+    container.insert_session(session);
+    container.remove_session(session);
+
+    EXPECT_THROW({
+        container.successor_of(session);
+    }, std::logic_error);
+}
+
+TEST(DefaultSessionContainer, inserting_a_session_twice_throws)
+{
+    using namespace ::testing;
+    ms::DefaultSessionContainer container;
+
+    auto session = std::make_shared<mtd::StubSession>();
+    container.insert_session(session);
+
+    EXPECT_THROW({
+        container.insert_session(session);
+    }, std::logic_error);
+}
@@ -27,12 +27,16 @@
 #include "mir/test/signal.h"
 #include "mir/test/current_thread_name.h"
 
+#include <boost/throw_exception.hpp>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <chrono>
 #include <thread>
 #include <atomic>
+#include <stdexcept>
+#include <string>
 
 namespace mg = mir::graphics;
 namespace ms = mir::scene;
@@ -121,3 +125,121 @@ TEST_F(ThreadedSnapshotStrategyTest, names_snapshot_thread)
 
     EXPECT_THAT(buffer_access.thread_name, Eq("Mir/Snapshot"));
 }
+
+TEST_F(ThreadedSnapshotStrategyTest, takes_snapshots_concurrently_with_multiple_pixel_buffers)
+{
+    using namespace testing;
+
+    mtd::NullPixelBuffer pixel_buffer1;
+    mtd::NullPixelBuffer pixel_buffer2;
+    mtd::StubBufferStream buffer_access2;
+
+    ms::ThreadedSnapshotStrategy strategy{
+        std::vector<std::shared_ptr<ms::PixelBuffer>>{
+            mt::fake_shared(pixel_buffer1),
+            mt::fake_shared(pixel_buffer2)}};
+
+    mt::Signal second_snapshot_taken;
+    std::atomic<bool> first_saw_second{false};
+    mt::Signal first_snapshot_taken;
+
+    /* The first snapshot can only complete if the second runs alongside it */
+    strategy.take_snapshot_of(
+        mt::fake_shared(buffer_access),
+        [&](ms::Snapshot const&)
+        {
+            first_saw_second = second_snapshot_taken.wait_for(std::chrono::seconds{5});
+            first_snapshot_taken.raise();
+        });
+
+    strategy.take_snapshot_of(
+        mt::fake_shared(buffer_access2),
+        [&](ms::Snapshot const&)
+        {
+            second_snapshot_taken.raise();
+        });
+
+    ASSERT_TRUE(first_snapshot_taken.wait_for(std::chrono::seconds{10}));
+    EXPECT_TRUE(first_saw_second);
+}
+
+TEST_F(ThreadedSnapshotStrategyTest, creates_pixel_buffers_on_first_snapshot)
+{
+    using namespace testing;
+
+    std::atomic<int> pixel_buffers_created{0};
+    std::string creating_thread;
+
+    ms::ThreadedSnapshotStrategy strategy{
+        [&]
+        {
+            creating_thread = mt::current_thread_name();
+            pixel_buffers_created += 2;
+            return std::vector<std::shared_ptr<ms::PixelBuffer>>{
+                std::make_shared<mtd::NullPixelBuffer>(),
+                std::make_shared<mtd::NullPixelBuffer>()};
+        }};
+
+    EXPECT_THAT(pixel_buffers_created, Eq(0));
+
+    mt::Signal snapshot_taken;
+
+    strategy.take_snapshot_of(
+        mt::fake_shared(buffer_access),
+        [&](ms::Snapshot const&)
+        {
+            snapshot_taken.raise();
+        });
+
+    EXPECT_TRUE(snapshot_taken.wait_for(std::chrono::seconds{5}));
+    EXPECT_THAT(pixel_buffers_created, Eq(2));
+    EXPECT_THAT(creating_thread, Eq("Mir/Snapshot"));
+
+    strategy.take_snapshot_of(mt::fake_shared(buffer_access), [](ms::Snapshot const&) {});
+
+    EXPECT_THAT(pixel_buffers_created, Eq(2));
+}
+
+TEST_F(ThreadedSnapshotStrategyTest, reports_empty_snapshot_and_retries_when_pixel_buffers_cannot_be_created)
+{
+    using namespace testing;
+
+    bool fail{true};
+
+    ms::ThreadedSnapshotStrategy strategy{
+        [&]
+        {
+            if (fail)
+                BOOST_THROW_EXCEPTION(std::runtime_error{"No GL for you"});
+
+            return std::vector<std::shared_ptr<ms::PixelBuffer>>{std::make_shared<mtd::NullPixelBuffer>()};
+        }};
+
+    mt::Signal failed_snapshot_taken;
+    ms::Snapshot failed_snapshot{{1, 1}, geom::Stride{1}, &fail};
+
+    strategy.take_snapshot_of(
+        mt::fake_shared(buffer_access),
+        [&](ms::Snapshot const& s)
+        {
+            failed_snapshot = s;
+            failed_snapshot_taken.raise();
+        });
+
+    ASSERT_TRUE(failed_snapshot_taken.wait_for(std::chrono::seconds{5}));
+    EXPECT_THAT(failed_snapshot.size, Eq(geom::Size{}));
+    EXPECT_THAT(failed_snapshot.pixels, Eq(nullptr));
+
+    fail = false;
+    mt::Signal snapshot_taken;
+
+    strategy.take_snapshot_of(
+        mt::fake_shared(buffer_access),
+        [&](ms::Snapshot const&)
+        {
+            snapshot_taken.raise();
+        });
+
+    EXPECT_TRUE(snapshot_taken.wait_for(std::chrono::seconds{5}));
+    EXPECT_THAT(buffer_access.thread_name, Eq("Mir/Snapshot"));
+}
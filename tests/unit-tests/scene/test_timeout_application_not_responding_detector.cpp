@@ -24,6 +24,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace mt = mir::time;
 namespace ms = mir::scene;
 namespace mtd = mir::test::doubles;
@@ -45,7 +48,7 @@ TEST(TimeoutApplicationNotRespondingDetector, pings_registered_sessions_on_sched
     
     mtd::FakeAlarmFactory fake_alarms;
     
-    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, 1s};
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, fake_alarms.the_clock(), 1s};
     
     bool first_session_pinged{false}, second_session_pinged{false};
     
@@ -72,7 +75,7 @@ TEST(TimeoutApplicationNotRespondingDetector, pings_repeatedly)
 
     mtd::FakeAlarmFactory fake_alarms;
 
-    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, 1s};
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, fake_alarms.the_clock(), 1s};
 
     int first_session_pinged{0}, second_session_pinged{0};
 
@@ -101,7 +104,7 @@ TEST(TimeoutApplicationNotRespondingDetector, triggers_anr_signal_when_session_f
 
     mtd::FakeAlarmFactory fake_alarms;
 
-    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, 1s};
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, fake_alarms.the_clock(), 1s};
 
     bool session_not_responding{false};
     auto observer = std::make_shared<NiceMock<MockObserver>>();
@@ -132,7 +135,7 @@ TEST(TimeoutApplicationNotRespondingDetector, does_not_trigger_anr_when_session_
 
     mtd::FakeAlarmFactory fake_alarms;
 
-    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, 1s};
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, fake_alarms.the_clock(), 1s};
 
     bool session_not_responding{false};
     auto observer = std::make_shared<NiceMock<MockObserver>>();
@@ -165,7 +168,7 @@ TEST(TimeoutApplicationNotRespondingDetector, triggers_now_responsive_signal_whe
 
     mtd::FakeAlarmFactory fake_alarms;
 
-    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, 1s};
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, fake_alarms.the_clock(), 1s};
 
     bool session_not_responding{false};
     auto observer = std::make_shared<NiceMock<MockObserver>>();
@@ -205,7 +208,7 @@ TEST(TimeoutApplicationNotRespondingDetector, fiddling_with_sessions_from_callba
 
     mtd::FakeAlarmFactory fake_alarms;
 
-    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, 1s};
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, fake_alarms.the_clock(), 1s};
 
     NiceMock<mtd::MockSceneSession> session_one, session_two, session_three;
 
@@ -242,7 +245,7 @@ TEST(TimeoutApplicationNotRespondingDetector, does_not_generate_signals_after_un
 
     mtd::FakeAlarmFactory fake_alarms;
 
-    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, 1s};
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, fake_alarms.the_clock(), 1s};
 
     bool session_not_responding{false};
     auto observer = std::make_shared<NiceMock<MockObserver>>();
@@ -285,7 +288,7 @@ TEST(TimeoutApplicationNotRespondingDetector, does_not_schedule_alarm_when_no_se
 
     mtd::FakeAlarmFactory fake_alarms;
 
-    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, 1s};
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, fake_alarms.the_clock(), 1s};
 
     // Go through several ping cycles.
     fake_alarms.advance_smoothly_by(5000ms);
@@ -316,7 +319,7 @@ TEST(TimeoutApplicationNotRespondingDetector, does_not_schedule_alarm_when_all_s
 
     mtd::FakeAlarmFactory fake_alarms;
 
-    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, 1s};
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, fake_alarms.the_clock(), 1s};
 
     NiceMock<mtd::MockSceneSession> session;
     bool session_unresponsive{false};
@@ -350,7 +353,7 @@ TEST(TimeoutApplicationNotRespondingDetector, session_switches_between_responsiv
 
     mtd::FakeAlarmFactory fake_alarms;
 
-    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, 1s};
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, fake_alarms.the_clock(), 1s};
 
     NiceMock<mtd::MockSceneSession> session;
     bool session_unresponsive{false};
@@ -391,7 +394,7 @@ TEST(TimeoutApplicationNotRespondingDetector, sends_unresponsive_notification_on
 
     mtd::FakeAlarmFactory fake_alarms;
 
-    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, 1s};
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, fake_alarms.the_clock(), 1s};
 
     NiceMock<mtd::MockSceneSession> session_one;
     NiceMock<mtd::MockSceneSession> session_two;
@@ -434,7 +437,7 @@ TEST(TimeoutApplicationNotRespondingDetector, sends_pings_on_schedule_as_session
     mtd::FakeAlarmFactory fake_alarms;
 
     auto const cycle_time = 1s;
-    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, cycle_time};
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, fake_alarms.the_clock(), cycle_time};
 
     NiceMock<mtd::MockSceneSession> session;
     std::atomic<int> ping_count{0};
@@ -469,3 +472,44 @@ TEST(TimeoutApplicationNotRespondingDetector, sends_pings_on_schedule_as_session
 
     EXPECT_THAT(ping_count, Ge(duration / cycle_time));
 }
+
+TEST(TimeoutApplicationNotRespondingDetector, spreads_pings_for_many_sessions_over_the_cycle)
+{
+    using namespace testing;
+    using namespace std::literals::chrono_literals;
+
+    mtd::FakeAlarmFactory fake_alarms;
+
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, fake_alarms.the_clock(), 1s};
+
+    int const session_count{1000};
+    std::vector<NiceMock<mtd::MockSceneSession>> sessions(session_count);
+    std::vector<int> ping_counts(session_count, 0);
+    std::vector<ms::Session const*> pinged;
+
+    for (int i = 0; i != session_count; ++i)
+    {
+        detector.register_session(&sessions[i], [&, i]()
+            {
+                ++ping_counts[i];
+                pinged.push_back(&sessions[i]);
+            });
+    }
+
+    std::size_t most_pings_at_once{0};
+
+    // The sessions all connected at once, but the pings shouldn't all happen at once
+    for (auto elapsed = 0ms; elapsed <= 3s; elapsed += 1ms)
+    {
+        fake_alarms.advance_by(1ms);
+
+        most_pings_at_once = std::max(most_pings_at_once, pinged.size());
+
+        for (auto const session : pinged)
+            detector.pong_received(session);
+        pinged.clear();
+    }
+
+    EXPECT_THAT(most_pings_at_once, Le(session_count / 10u));
+    EXPECT_THAT(ping_counts, Each(Eq(3)));
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/basic_observers.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+namespace
+{
+struct Observer
+{
+    virtual ~Observer() = default;
+    virtual void notify() = 0;
+};
+
+struct CountingObserver : Observer
+{
+    void notify() override { ++count; }
+    std::atomic<int> count{0};
+};
+
+struct TestObservers : Observer, mir::BasicObservers<Observer>
+{
+    using mir::BasicObservers<Observer>::add;
+    using mir::BasicObservers<Observer>::remove;
+
+    void notify() override
+    {
+        for_each([](std::shared_ptr<Observer> const& observer) { observer->notify(); });
+    }
+};
+
+struct BasicObserversTest : testing::Test
+{
+    TestObservers observers;
+
+    std::shared_ptr<CountingObserver> const observer1 = std::make_shared<CountingObserver>();
+    std::shared_ptr<CountingObserver> const observer2 = std::make_shared<CountingObserver>();
+};
+
+struct CallbackObserver : Observer
+{
+    explicit CallbackObserver(std::function<void()> const& callback) : callback{callback} {}
+    void notify() override { callback(); }
+    std::function<void()> const callback;
+};
+}
+
+TEST_F(BasicObserversTest, notifies_each_added_observer)
+{
+    observers.add(observer1);
+    observers.add(observer2);
+
+    observers.notify();
+
+    EXPECT_THAT(observer1->count, testing::Eq(1));
+    EXPECT_THAT(observer2->count, testing::Eq(1));
+}
+
+TEST_F(BasicObserversTest, does_not_notify_removed_observer)
+{
+    observers.add(observer1);
+    observers.add(observer2);
+
+    observers.remove(observer1);
+    observers.notify();
+
+    EXPECT_THAT(observer1->count, testing::Eq(0));
+    EXPECT_THAT(observer2->count, testing::Eq(1));
+}
+
+TEST_F(BasicObserversTest, observer_can_remove_itself_while_notified)
+{
+    std::shared_ptr<Observer> self;
+    int calls = 0;
+    self = std::make_shared<CallbackObserver>([&] { ++calls; observers.remove(self); });
+
+    observers.add(self);
+    observers.notify();
+    observers.notify();
+
+    EXPECT_THAT(calls, testing::Eq(1));
+}
+
+TEST_F(BasicObserversTest, observer_removed_during_notification_is_not_called)
+{
+    auto const remover = std::make_shared<CallbackObserver>([&] { observers.remove(observer2); });
+
+    observers.add(remover);
+    observers.add(observer2);
+    observers.notify();
+
+    EXPECT_THAT(observer2->count, testing::Eq(0));
+}
+
+TEST_F(BasicObserversTest, observer_added_during_notification_is_called_from_next_notification)
+{
+    auto const adder = std::make_shared<CallbackObserver>([&] { observers.add(observer1); });
+
+    observers.add(adder);
+    observers.notify();
+
+    EXPECT_THAT(observer1->count, testing::Eq(0));
+
+    observers.remove(adder);
+    observers.notify();
+
+    EXPECT_THAT(observer1->count, testing::Eq(1));
+}
+
+TEST_F(BasicObserversTest, notifies_while_observers_are_changed_on_another_thread)
+{
+    observers.add(observer1);
+
+    std::atomic<bool> done{false};
+    std::thread changer{
+        [&]
+        {
+            while (!done)
+            {
+                observers.add(observer2);
+                observers.remove(observer2);
+            }
+        }};
+
+    for (int i = 0; i != 10000; ++i)
+        observers.notify();
+
+    done = true;
+    changer.join();
+
+    EXPECT_THAT(observer1->count, testing::Eq(10000));
+}
+
+TEST_F(BasicObserversTest, remove_waits_for_a_notification_in_progress_on_another_thread)
+{
+    std::atomic<bool> in_callback{false};
+    std::atomic<bool> release_callback{false};
+    std::atomic<bool> callback_finished{false};
+
+    auto const slow = std::make_shared<CallbackObserver>([&]
+        {
+            in_callback = true;
+            while (!release_callback) std::this_thread::yield();
+            callback_finished = true;
+        });
+
+    observers.add(slow);
+
+    std::thread notifier{[&] { observers.notify(); }};
+    while (!in_callback) std::this_thread::yield();
+
+    std::atomic<bool> removed{false};
+    std::thread remover{[&] { observers.remove(slow); removed = true; }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    EXPECT_FALSE(removed);
+
+    release_callback = true;
+    remover.join();
+    notifier.join();
+
+    EXPECT_TRUE(callback_finished);
+}